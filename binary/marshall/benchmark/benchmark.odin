@@ -0,0 +1,37 @@
+//+build windows
+package main
+
+import "core:mem"
+
+/**
+ * @brief allocator wrapper which only counts how many times (and how much) the backing allocator has been asked for memory
+ */
+Counting_Allocator :: struct {
+    backing: mem.Allocator,
+    allocations: int,
+    bytes: int,
+}
+
+counting_allocator_proc :: proc(
+    allocator_data: rawptr, mode: mem.Allocator_Mode,
+    size, alignment: int,
+    old_memory: rawptr, old_size: int,
+    location := #caller_location,
+) -> ([]byte, mem.Allocator_Error) {
+    counter := cast(^Counting_Allocator)allocator_data;
+    #partial switch mode {
+        case .Alloc, .Alloc_Non_Zeroed, .Resize:
+            counter.allocations += 1;
+            counter.bytes += size;
+    }
+    return counter.backing.procedure(counter.backing.data, mode, size, alignment, old_memory, old_size, location);
+}
+
+counting_allocator :: #force_inline proc(counter: ^Counting_Allocator) -> mem.Allocator {
+    return { procedure = counting_allocator_proc, data = counter, };
+}
+
+main :: proc() {
+    benchmark_serialize();
+    benchmark_pod();
+}
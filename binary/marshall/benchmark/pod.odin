@@ -0,0 +1,192 @@
+//+build windows
+package main
+
+import "core:fmt"
+import "core:os"
+import "core:time"
+import "core:math/rand"
+import "core:reflect"
+
+import binary   "nexa_external:binary"
+import marshall "nexa_external:binary/marshall"
+
+POD_ELEMENTS   :: 1 << 22;
+POD_TABLE_SIZE :: 1 << 16;
+POD_FILE       :: "pod_benchmark.dat";
+
+report_pod :: proc(name: string, duration: time.Duration, elements: int) {
+    fmt.printf(
+        "\t%-36s %10.3f ms %14.0f elements/s\n",
+        name,
+        time.duration_milliseconds(duration),
+        f64(elements) / time.duration_seconds(duration),
+    );
+}
+
+benchmark_pod :: proc() {
+    fmt.printf("\nBeginning [POD BENCHMARK] %v elements\n", POD_ELEMENTS);
+    fmt.printf("-----------------------------\n");
+
+    vertices := make([]u32, POD_ELEMENTS);
+    defer delete(vertices);
+    for &v in vertices do v = rand.uint32();
+
+    // reference: what the marshaller used to do for every element (serialize + deserialize one at a time)
+    {
+        byte_data := make([]byte, 8 + POD_ELEMENTS * size_of(u32));
+        defer delete(byte_data);
+        start := time.tick_now();
+        for &v, i in vertices {
+            _, err := marshall.serialize_into(v, byte_data[8 + i * size_of(u32):]);
+            assert(err == .None);
+        }
+        report_pod("per element serialize", time.tick_since(start), POD_ELEMENTS);
+
+        deserialized := make([]u32, POD_ELEMENTS);
+        defer delete(deserialized);
+        start = time.tick_now();
+        for &v, i in deserialized {
+            err := marshall.deserialize(v, byte_data[8 + i * size_of(u32) : 8 + (i + 1) * size_of(u32)]);
+            assert(err == .None);
+        }
+        report_pod("per element deserialize", time.tick_since(start), POD_ELEMENTS);
+    }
+
+    // runtime (Type_Info) detected block copy
+    {
+        start := time.tick_now();
+        byte_data, err := marshall.serialize(vertices);
+        assert(err == .None);
+        defer delete(byte_data);
+        report_pod("serialize []u32", time.tick_since(start), POD_ELEMENTS);
+
+        deserialized: []u32;
+        defer delete(deserialized);
+        start = time.tick_now();
+        err = marshall.deserialize(deserialized, byte_data);
+        assert(err == .None);
+        report_pod("deserialize []u32", time.tick_since(start), POD_ELEMENTS);
+        for v, i in vertices do fmt.assertf(v == deserialized[i], "Values do not match at [%v]: %v :: %v\n", i, v, deserialized[i]);
+    }
+
+    // compile time ($T) detected block copy, including the file round trip
+    {
+        start := time.tick_now();
+        {
+            writer := binary.init_writer(POD_FILE);
+            defer binary.dump_writer(&writer);
+            err := marshall.marshall_write_explicit(vertices, &writer);
+            assert(err == .None);
+        }
+        report_pod("marshall_write_explicit []u32", time.tick_since(start), POD_ELEMENTS);
+
+        start = time.tick_now();
+        reader := binary.init_reader();
+        defer binary.dump_reader(&reader);
+        binary.load(&reader, POD_FILE);
+        deserialized, err := marshall.marshall_read_explicit([]u32, &reader);
+        assert(err == .None);
+        defer delete(deserialized);
+        report_pod("marshall_read_explicit []u32", time.tick_since(start), POD_ELEMENTS);
+        for v, i in vertices do fmt.assertf(v == deserialized[i], "Values do not match at [%v]: %v :: %v\n", i, v, deserialized[i]);
+    }
+
+    // static tables
+    {
+        table := new([POD_TABLE_SIZE]u32);
+        defer free(table);
+        for &v in table do v = rand.uint32();
+
+        start := time.tick_now();
+        byte_data, err := marshall.serialize(table^);
+        assert(err == .None);
+        defer delete(byte_data);
+        report_pod("serialize [N]u32", time.tick_since(start), POD_TABLE_SIZE);
+
+        deserialized := new([POD_TABLE_SIZE]u32);
+        defer free(deserialized);
+        start = time.tick_now();
+        err = marshall.deserialize(deserialized^, byte_data);
+        assert(err == .None);
+        report_pod("deserialize [N]u32", time.tick_since(start), POD_TABLE_SIZE);
+        fmt.assertf(table^ == deserialized^, "Tables do not match!\n");
+    }
+
+    os.remove(POD_FILE);
+    benchmark_float_pod();
+}
+
+/**
+ * @brief what 'serialize' did for an indexable of floats before the batch loop: sizes, then one 'serialize' (one allocation, one 'any' dispatch) per element
+ */
+legacy_serialize_indexable :: proc(arr: any, count: int) -> []byte {
+    total_size := 0;
+    for it := 0; it < count; {
+        val, _, fine := reflect.iterate_array(arr, &it);
+        if !fine do break;
+        total_size += marshall.marshall_serialized_size(val);
+    }
+    byte_data := make([]byte, 8 + total_size);
+    length, _ := marshall.serialize(u64(count) << 32 | u64(total_size + 8));
+    copy(byte_data[:8], length);
+    delete(length);
+    pos := 8;
+    for it := 0; it < count; {
+        val, _, fine := reflect.iterate_array(arr, &it);
+        if !fine do break;
+        serialized, err := marshall.serialize(val);
+        assert(err == .None);
+        copy(byte_data[pos:], serialized);
+        pos += len(serialized);
+        delete(serialized);
+    }
+    return byte_data;
+}
+
+benchmark_float_pod :: proc() {
+    fmt.printf("\nBeginning [FLOAT POD BENCHMARK] %v elements\n", POD_ELEMENTS);
+    fmt.printf("-----------------------------\n");
+
+    vertices := make([]f32, POD_ELEMENTS);
+    defer delete(vertices);
+    for &v in vertices do v = (rand.float32() - 0.5) * 1e4;
+    STRIDE :: 1 + size_of(i16le) + size_of(u32le); // sign, exponent, mantissa
+
+    // before: element by element, through 'any'
+    legacy: []byte;
+    defer delete(legacy);
+    {
+        start := time.tick_now();
+        legacy = legacy_serialize_indexable(vertices, len(vertices));
+        report_pod("pre-change serialize []f32", time.tick_since(start), POD_ELEMENTS);
+
+        // the element decode of the old loop ('deserialize' of every element, as f32le: platform f32 elements were decoded as integers)
+        deserialized := make([]f32le, POD_ELEMENTS);
+        defer delete(deserialized);
+        start = time.tick_now();
+        for &v, i in deserialized {
+            err := marshall.deserialize(v, legacy[8 + i * STRIDE : 8 + (i + 1) * STRIDE]);
+            assert(err == .None);
+        }
+        report_pod("pre-change deserialize []f32", time.tick_since(start), POD_ELEMENTS);
+    }
+
+    // now: one typed loop over the whole slice
+    {
+        start := time.tick_now();
+        byte_data, err := marshall.serialize(vertices);
+        assert(err == .None);
+        defer delete(byte_data);
+        report_pod("serialize []f32", time.tick_since(start), POD_ELEMENTS);
+        fmt.assertf(len(byte_data) == len(legacy), "Sizes do not match: %v :: %v\n", len(byte_data), len(legacy));
+        for b, i in byte_data do fmt.assertf(b == legacy[i], "Encodings differ at byte [%v]\n", i);
+
+        deserialized: []f32;
+        defer delete(deserialized);
+        start = time.tick_now();
+        err = marshall.deserialize(deserialized, byte_data);
+        assert(err == .None);
+        report_pod("deserialize []f32", time.tick_since(start), POD_ELEMENTS);
+        for v, i in vertices do fmt.assertf(v == deserialized[i], "Values do not match at [%v]: %v :: %v\n", i, v, deserialized[i]);
+    }
+}
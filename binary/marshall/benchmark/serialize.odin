@@ -0,0 +1,135 @@
+//+build windows
+package main
+
+import "core:fmt"
+import "core:mem"
+import "core:time"
+import "core:math/rand"
+
+import marshall "nexa_external:binary/marshall"
+
+Benchmark_Leaf :: struct {
+    id:     int         "NexaTag_Marshallable",
+    weight: f32le       "NexaTag_Marshallable",
+    name:   string      "NexaTag_Marshallable",
+    flags:  [4]u8       "NexaTag_Marshallable",
+}
+
+Benchmark_Node :: struct {
+    leaf:     Benchmark_Leaf    "NexaTag_Marshallable",
+    children: []Benchmark_Leaf  "NexaTag_Marshallable",
+    values:   [dynamic]i32      "NexaTag_Marshallable",
+    cache:    rawptr, // not going to be serialized
+}
+
+BENCHMARK_NODES      :: 2048;
+BENCHMARK_CHILDREN   :: 32;
+BENCHMARK_VALUES     :: 64;
+BENCHMARK_ITERATIONS :: 32;
+
+make_leaf :: proc() -> Benchmark_Leaf {
+    name := make([]byte, rand.int_max(16) + 1);
+    for &c in name do c = cast(byte)rand.int_max(26) + 65;
+    return {
+        id = rand.int_max(1 << 30),
+        weight = cast(f32le)rand.float32(),
+        name = string(name),
+        flags = { u8(rand.int_max(256)), u8(rand.int_max(256)), u8(rand.int_max(256)), u8(rand.int_max(256)) },
+    };
+}
+
+make_nodes :: proc() -> []Benchmark_Node {
+    nodes := make([]Benchmark_Node, BENCHMARK_NODES);
+    for &node in nodes {
+        node.leaf = make_leaf();
+        node.children = make([]Benchmark_Leaf, BENCHMARK_CHILDREN);
+        for &child in node.children do child = make_leaf();
+        node.values = make([dynamic]i32, BENCHMARK_VALUES);
+        for &value in node.values do value = cast(i32)rand.int_max(1 << 30);
+    }
+    return nodes;
+}
+
+dump_nodes :: proc(nodes: []Benchmark_Node) {
+    for node in nodes {
+        delete(node.leaf.name);
+        for child in node.children do delete(child.name);
+        delete(node.children);
+        delete(node.values);
+    }
+    delete(nodes);
+}
+
+report_serialize :: proc(name: string, duration: time.Duration, byte_size: int, counter: ^Counting_Allocator) {
+    seconds := time.duration_seconds(duration);
+    fmt.printf(
+        "\t%-20s %10.3f ms/iter %10.2f MB/s %10d allocs/iter %12d bytes allocated/iter\n",
+        name,
+        time.duration_milliseconds(duration) / BENCHMARK_ITERATIONS,
+        f64(byte_size * BENCHMARK_ITERATIONS) / (1024 * 1024) / seconds,
+        counter.allocations / BENCHMARK_ITERATIONS,
+        counter.bytes / BENCHMARK_ITERATIONS,
+    );
+}
+
+benchmark_serialize :: proc() {
+    nodes := make_nodes();
+    defer dump_nodes(nodes);
+
+    reference, err := marshall.serialize(nodes);
+    fmt.assertf(err == .None, "\x1b[33mSerialization\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+    defer delete(reference);
+    fmt.assertf(
+        len(reference) == marshall.marshall_serialized_size(nodes),
+        "Sizes do not match: %v[serialize] :: %v[marshall_serialized_size]\n",
+        len(reference), marshall.marshall_serialized_size(nodes),
+    );
+
+    fmt.printf("\nBeginning [SERIALIZE BENCHMARK] %v nodes x %v children, %v bytes\n", BENCHMARK_NODES, BENCHMARK_CHILDREN, len(reference));
+    fmt.printf("-----------------------------\n");
+
+    // serialize (one allocation per field + copies per nesting level)
+    {
+        counter := Counting_Allocator{ backing = context.allocator, };
+        context.allocator = counting_allocator(&counter);
+        start := time.tick_now();
+        for _ in 0..<BENCHMARK_ITERATIONS {
+            byte_data, serr := marshall.serialize(nodes);
+            assert(serr == .None);
+            delete(byte_data);
+        }
+        report_serialize("serialize", time.tick_since(start), len(reference), &counter);
+    }
+
+    // serialize_into (caller supplied buffer, reused between iterations)
+    {
+        out := make([]byte, len(reference));
+        defer delete(out);
+        counter := Counting_Allocator{ backing = context.allocator, };
+        context.allocator = counting_allocator(&counter);
+        start := time.tick_now();
+        for _ in 0..<BENCHMARK_ITERATIONS {
+            written, serr := marshall.serialize_into(nodes, out);
+            assert(serr == .None && written == len(reference));
+        }
+        report_serialize("serialize_into", time.tick_since(start), len(reference), &counter);
+        fmt.assertf(mem.compare(out, reference) == 0, "serialize_into does not produce the same bytes as serialize!\n");
+    }
+
+    // serialize_arena (sized once, one arena allocation per call)
+    {
+        backing := make([]byte, len(reference) + 64);
+        defer delete(backing);
+        arena: mem.Arena;
+        mem.arena_init(&arena, backing);
+        counter := Counting_Allocator{ backing = context.allocator, };
+        context.allocator = counting_allocator(&counter);
+        start := time.tick_now();
+        for _ in 0..<BENCHMARK_ITERATIONS {
+            byte_data, serr := marshall.serialize_arena(nodes, &arena);
+            assert(serr == .None && len(byte_data) == len(reference));
+            mem.free_all(mem.arena_allocator(&arena));
+        }
+        report_serialize("serialize_arena", time.tick_since(start), len(reference), &counter);
+    }
+}
@@ -37,6 +37,106 @@ type_is_struct ::  proc "contextless" (t: ^runtime.Type_Info) -> bool {
 	return ok && !s.is_raw_union;
 } 
 
+/**
+ * @brief element types whose serialized form is byte-for-byte their in-memory form (integers are always written in their own declared byte order)
+ * @note indexables of these are written/read as one contiguous block instead of element by element
+ * @return size of one element; -1 if the element has to go through 'serialize'/'deserialize' one by one
+ */
+marshall_pod_size_t :: proc "contextless" (t: ^runtime.Type_Info) -> int {
+    if t == nil do return -1;
+    base := runtime.type_info_base(t);
+    #partial switch v in base.variant {
+        case runtime.Type_Info_Integer:
+            if base.id == typeid_of(uintptr) || base.size > 8 do return -1; // same types 'serialize' refuses
+            return base.size;
+        case runtime.Type_Info_Rune:
+            return size_of(rune);
+        case runtime.Type_Info_Enum:
+            return marshall_pod_size_t(v.base);
+    }
+    return -1;
+}
+
+/**
+ * @brief float element types written/read by one typed loop ('_serialize_float_block'/'_deserialize_float_block') instead of one 'serialize'/'deserialize' per element
+ * @note the encoding stays the one of 'interpret_float_le_data' (sign, exponent, mantissa); platform floats only on little endian targets, f16 and big endian floats still go one by one
+ * @return size of one serialized element; -1 if the element type has no batch loop
+ */
+marshall_float_block_size_t :: proc "contextless" (t: ^runtime.Type_Info) -> int {
+    if t == nil do return -1;
+    base := runtime.type_info_base(t);
+    v, ok := base.variant.(runtime.Type_Info_Float);
+    if !ok || v.endianness == .Big do return -1;
+    when ODIN_ENDIAN == .Big {
+        if v.endianness == .Platform do return -1;
+    }
+    switch base.size {
+        case size_of(f32): return size_of(u8) /* sign */ + size_of(i16le) /* exp */ + size_of(u32le) /* mantissa */;
+        case size_of(f64): return size_of(u8) /* sign */ + size_of(i32le) /* exp */ + size_of(u64le) /* mantissa */;
+    }
+    return -1;
+}
+
+@(private)
+_serialize_float_block_t :: proc "contextless" (offsets: FloatOffsetsTable($EXP, $MANTISSA), elements: rawptr, count: int, out: []byte) {
+    STRIDE :: size_of(u8) + size_of(EXP) + size_of(MANTISSA);
+    bits := ([^]MANTISSA)(elements);
+    #no_bounds_check for i in 0..<count {
+        element := raw_data(out[i * STRIDE:]);
+        element[0] = u8(bits[i] >> (size_of(MANTISSA) * 8 - 1));
+        intrinsics.unaligned_store((^EXP)(&element[size_of(u8)]), cast(EXP)((bits[i] & offsets.exponent_mask) >> auto_cast offsets.exponent_shift));
+        intrinsics.unaligned_store((^MANTISSA)(&element[size_of(u8) + size_of(EXP)]), bits[i] & offsets.mantissa_mask);
+    }
+}
+
+@(private)
+_deserialize_float_block_t :: proc "contextless" (offsets: FloatOffsetsTable($EXP, $MANTISSA), elements: rawptr, count: int, data: []byte) {
+    STRIDE :: size_of(u8) + size_of(EXP) + size_of(MANTISSA);
+    bits := ([^]MANTISSA)(elements);
+    #no_bounds_check for i in 0..<count {
+        element := raw_data(data[i * STRIDE:]);
+        exp := intrinsics.unaligned_load((^EXP)(&element[size_of(u8)]));
+        mantissa := intrinsics.unaligned_load((^MANTISSA)(&element[size_of(u8) + size_of(EXP)]));
+        bits[i] = MANTISSA(element[0] & 1) << (size_of(MANTISSA) * 8 - 1) |
+            (MANTISSA(exp) << auto_cast offsets.exponent_shift) & offsets.exponent_mask |
+            mantissa & offsets.mantissa_mask;
+    }
+}
+
+/**
+ * @brief writes "count" float elements (@see marshall_float_block_size_t) into "out", which has to hold count * marshall_float_block_size_t(elem) bytes
+ */
+@(private)
+_serialize_float_block :: #force_inline proc "contextless" (elem: ^runtime.Type_Info, elements: rawptr, count: int, out: []byte) {
+    if elem.size == size_of(f32) do _serialize_float_block_t(F32le_OFFSETS_TABLE, elements, count, out);
+    else do _serialize_float_block_t(F64le_OFFSETS_TABLE, elements, count, out);
+}
+
+/**
+ * @brief reads "count" float elements (@see marshall_float_block_size_t) following the 8 byte indexable header of "data"
+ */
+@(private)
+_deserialize_float_block :: #force_inline proc "contextless" (elem: ^runtime.Type_Info, elements: rawptr, count: int, data: []byte) -> Marshall_Error {
+    if 8 + count * marshall_float_block_size_t(elem) > len(data) do return .BufferOverflow;
+    if elem.size == size_of(f32) do _deserialize_float_block_t(F32le_OFFSETS_TABLE, elements, count, data[8:]);
+    else do _deserialize_float_block_t(F64le_OFFSETS_TABLE, elements, count, data[8:]);
+    return .None;
+}
+
+/**
+ * @return pointer to the first element and the element type of an array/slice/dynamic array; nil for any other type
+ */
+@(private)
+_indexable_raw_data :: #force_inline proc "contextless" (arr: any) -> (data: rawptr, elem: ^runtime.Type_Info) {
+    #partial switch v in runtime.type_info_base(type_info_of(arr.id)).variant {
+        case runtime.Type_Info_Array:           return arr.data, v.elem;
+        case runtime.Type_Info_Enumerated_Array: return arr.data, v.elem;
+        case runtime.Type_Info_Slice:           return (cast(^runtime.Raw_Slice)arr.data).data, v.elem;
+        case runtime.Type_Info_Dynamic_Array:   return (cast(^runtime.Raw_Dynamic_Array)arr.data).data, v.elem;
+    }
+    return nil, nil;
+}
+
 /**
  * @brief helper functions for data serialization
  */
@@ -110,10 +210,11 @@ interpret_float_data :: proc(float: any) -> ([]byte, Marshall_Error) {
     return {}, .UnknownError;
 }
 
-interpret_float_le_data :: proc(float_data: $FLOAT_T, offsets: FloatOffsetsTable($EXP, $MANTISSA)) -> []byte
+interpret_float_le_data :: proc(float_data: $FLOAT_T, offsets: FloatOffsetsTable($EXP, $MANTISSA), byte_data: []byte = nil) -> []byte
     where intrinsics.type_is_float(FLOAT_T) && intrinsics.type_is_endian_little(FLOAT_T)
 {
     float_data := float_data;
+    byte_data := byte_data;
     float_bits := transmute(MANTISSA)float_data;
     // first bit determines +/-
     neg := cast(u8)((float_bits >> (size_of(MANTISSA) * 8 - 1)) & 1);
@@ -123,7 +224,7 @@ interpret_float_le_data :: proc(float_data: $FLOAT_T, offsets: FloatOffsetsTable
     // multiplied by exp_bits; 10 bit long after exp_bits
     mantissa := (float_bits & offsets.mantissa_mask);
 
-    byte_data := make([]byte, size_of(u8) + size_of(exp_bits) + size_of(mantissa));
+    if byte_data == nil do byte_data = make([]byte, size_of(u8) + size_of(exp_bits) + size_of(mantissa));
     interpret_int_le_data(neg,      byte_data[:]);
     interpret_int_le_data(exp_bits, byte_data[size_of(neg):]);
     interpret_int_le_data(mantissa, byte_data[size_of(neg) + size_of(exp_bits):]);
@@ -202,6 +303,21 @@ interpret_indexable :: proc(arr: any, count: int) -> (byte_data: []byte, err: Ma
 
     if count > 1 << (size_of(u32) * 8) do return nil, .ArrayTooLong;
 
+    if elements, elem := _indexable_raw_data(arr); marshall_pod_size_t(elem) != -1 {
+        block_size := count * marshall_pod_size_t(elem);
+        byte_data = make([]byte, 8 + block_size);
+        interpret_int_data((u64(count) << 32) | u64(block_size + 8), byte_data[:8]);
+        if block_size > 0 do mem.copy_non_overlapping(raw_data(byte_data[8:]), elements, block_size);
+        return;
+    }
+    if elements, elem := _indexable_raw_data(arr); marshall_float_block_size_t(elem) != -1 {
+        block_size := count * marshall_float_block_size_t(elem);
+        byte_data = make([]byte, 8 + block_size);
+        interpret_int_data((u64(count) << 32) | u64(block_size + 8), byte_data[:8]);
+        _serialize_float_block(elem, elements, count, byte_data[8:]);
+        return;
+    }
+
     ByteData :: struct {
         data: []byte,
     }
@@ -236,6 +352,13 @@ interpret_indexable :: proc(arr: any, count: int) -> (byte_data: []byte, err: Ma
 interpret_enum_array :: proc(arr: any, info: runtime.Type_Info_Enumerated_Array) -> (byte_data: []byte, err: Marshall_Error) {
     total_size := 0;
     if info.is_sparse do return nil, .UnknownError;
+    if elem_size := marshall_pod_size_t(info.elem); elem_size != -1 {
+        block_size := info.count * elem_size;
+        byte_data = make([]byte, 8 + block_size);
+        interpret_int_data((u64(info.count) << 32) | u64(block_size + 8), byte_data[:8]);
+        if block_size > 0 do mem.copy_non_overlapping(raw_data(byte_data[8:]), arr.data, block_size);
+        return;
+    }
     for it := 0; it < info.count; it += 1 {
         total_size += marshall_serialized_size(
             any { cast(rawptr)(uintptr(arr.data) + uintptr(it * info.elem_size)), info.elem.id },
@@ -447,6 +570,282 @@ serialize :: proc(data: any) -> ([]byte, Marshall_Error) {
     return nil, .UnknownError;
 }
 
+/* SERIALIZE INTO */
+_FLOAT16_SERIALIZED_SIZE :: size_of(u8) /* sign */ + size_of(i8)    /* exp */ + size_of(u16le) /* mantissa */;
+_FLOAT32_SERIALIZED_SIZE :: size_of(u8) /* sign */ + size_of(i16le) /* exp */ + size_of(u32le) /* mantissa */;
+_FLOAT64_SERIALIZED_SIZE :: size_of(u8) /* sign */ + size_of(i32le) /* exp */ + size_of(u64le) /* mantissa */;
+
+/**
+ * @brief hands out the next "size" bytes of "out" and moves the cursor past them
+ */
+@(private)
+_serialize_reserve :: #force_inline proc "contextless" (out: []byte, pos: ^int, size: int) -> ([]byte, Marshall_Error) {
+    if pos^ + size > len(out) do return nil, .BufferOverflow;
+    bytes := out[pos^ : pos^ + size];
+    pos^ += size;
+    return bytes, .None;
+}
+
+@(private)
+_serialize_int_into :: #force_inline proc(integer_data: $INT_T, out: []byte, pos: ^int) -> Marshall_Error
+    where intrinsics.type_is_integer(INT_T)
+{
+    bytes := _serialize_reserve(out, pos, size_of(INT_T)) or_return;
+    when intrinsics.type_is_endian_big(INT_T) {
+        interpret_int_be_data(integer_data, bytes);
+    } else {
+        interpret_int_le_data(integer_data, bytes);
+    }
+    return .None;
+}
+
+@(private)
+_serialize_float_into :: proc(float: any, out: []byte, pos: ^int) -> Marshall_Error {
+    switch float_data in float {
+        case f16:
+            bytes := _serialize_reserve(out, pos, _FLOAT16_SERIALIZED_SIZE) or_return;
+            interpret_float_le_data(cast(f16le)float_data, F16le_OFFSETS_TABLE, bytes);
+        case f32:
+            bytes := _serialize_reserve(out, pos, _FLOAT32_SERIALIZED_SIZE) or_return;
+            interpret_float_le_data(cast(f32le)float_data, F32le_OFFSETS_TABLE, bytes);
+        case f64:
+            bytes := _serialize_reserve(out, pos, _FLOAT64_SERIALIZED_SIZE) or_return;
+            interpret_float_le_data(cast(f64le)float_data, F64le_OFFSETS_TABLE, bytes);
+
+        case f16le:
+            bytes := _serialize_reserve(out, pos, _FLOAT16_SERIALIZED_SIZE) or_return;
+            interpret_float_le_data(float_data, F16le_OFFSETS_TABLE, bytes);
+        case f32le:
+            bytes := _serialize_reserve(out, pos, _FLOAT32_SERIALIZED_SIZE) or_return;
+            interpret_float_le_data(float_data, F32le_OFFSETS_TABLE, bytes);
+        case f64le:
+            bytes := _serialize_reserve(out, pos, _FLOAT64_SERIALIZED_SIZE) or_return;
+            interpret_float_le_data(float_data, F64le_OFFSETS_TABLE, bytes);
+
+        // 'interpret_float_be_data' does not produce any bytes yet, refuse instead of silently writing nothing
+        case f16be, f32be, f64be:
+            return .InvalidEndianness;
+
+        case:
+            return .UnknownError;
+    }
+    return .None;
+}
+
+@(private)
+_serialize_string_into :: proc(str: string, out: []byte, pos: ^int) -> Marshall_Error {
+    if len(str) > (1 << (size_of(u32) * 8)) do return .StringTooLong;
+    _serialize_int_into(u32(len(str)), out, pos) or_return;
+    bytes := _serialize_reserve(out, pos, len(str)) or_return;
+    copy_from_string(bytes, str);
+    return .None;
+}
+
+/**
+ * @note the 8 byte header (count << 32 | byte size) is reserved first and patched once all the elements are written, so each element is visited only once
+ */
+@(private)
+_serialize_indexable_into :: proc(arr: any, count: int, out: []byte, pos: ^int) -> Marshall_Error {
+    if count > 1 << (size_of(u32) * 8) do return .ArrayTooLong;
+
+    header := _serialize_reserve(out, pos, 8) or_return;
+    begin := pos^;
+    if elements, elem := _indexable_raw_data(arr); marshall_pod_size_t(elem) != -1 {
+        block := _serialize_reserve(out, pos, count * marshall_pod_size_t(elem)) or_return;
+        if len(block) > 0 do mem.copy_non_overlapping(raw_data(block), elements, len(block));
+        interpret_int_data((u64(count) << 32) | u64(len(block) + 8), header);
+        return .None;
+    }
+    if elements, elem := _indexable_raw_data(arr); marshall_float_block_size_t(elem) != -1 {
+        block := _serialize_reserve(out, pos, count * marshall_float_block_size_t(elem)) or_return;
+        _serialize_float_block(elem, elements, count, block);
+        interpret_int_data((u64(count) << 32) | u64(len(block) + 8), header);
+        return .None;
+    }
+    for it := 0; it < count; {
+        val, _, fine := reflect.iterate_array(arr, &it);
+        if !fine do break;
+
+        _serialize_into(val, out, pos) or_return;
+    }
+    interpret_int_data((u64(count) << 32) | u64(pos^ - begin + 8), header);
+    return .None;
+}
+
+@(private)
+_serialize_enum_array_into :: proc(arr: any, info: runtime.Type_Info_Enumerated_Array, out: []byte, pos: ^int) -> Marshall_Error {
+    if info.is_sparse do return .UnknownError;
+
+    header := _serialize_reserve(out, pos, 8) or_return;
+    begin := pos^;
+    if elem_size := marshall_pod_size_t(info.elem); elem_size != -1 {
+        block := _serialize_reserve(out, pos, info.count * elem_size) or_return;
+        if len(block) > 0 do mem.copy_non_overlapping(raw_data(block), arr.data, len(block));
+        interpret_int_data((u64(info.count) << 32) | u64(len(block) + 8), header);
+        return .None;
+    }
+    for it := 0; it < info.count; it += 1 {
+        _serialize_into(
+            any { cast(rawptr)(uintptr(arr.data) + uintptr(it * info.elem_size)), info.elem.id },
+            out, pos,
+        ) or_return;
+    }
+    interpret_int_data((u64(info.count) << 32) | u64(pos^ - begin + 8), header);
+    return .None;
+}
+
+@(private)
+_serialize_struct_into :: proc(base_data: any, v: runtime.Type_Info_Struct, out: []byte, pos: ^int, recurrent := false) -> Marshall_Error {
+    if v.is_raw_union do return .StructIsRawUnion;
+
+    header := _serialize_reserve(out, pos, size_of(u32)) or_return;
+    begin := pos^;
+    for offset, index in v.offsets {
+        type_info := v.types[index];
+        if v.tags[index] == "NexaTag_Marshallable" || recurrent {
+            field := any {
+                data = cast(rawptr)(uintptr(base_data.data) + offset),
+                id = type_info.id,
+            };
+            if type_is_struct(type_info) {
+                _serialize_struct_into(
+                    field,
+                    runtime.type_info_base(type_info).variant.(runtime.Type_Info_Struct),
+                    out, pos,
+                    true,
+                ) or_return;
+            } else {
+                _serialize_into(field, out, pos) or_return;
+            }
+        }
+    }
+    interpret_int_data(u32(pos^ - begin), header);
+    return .None;
+}
+
+@(private)
+_serialize_into :: proc(data: any, out: []byte, pos: ^int) -> Marshall_Error {
+    type_info := runtime.type_info_base(type_info_of(data.id));
+    base_data := any{data.data, type_info.id}
+
+    #partial switch v in type_info.variant {
+        case runtime.Type_Info_Integer:
+            switch integer_data in base_data {
+                case i8:      return _serialize_int_into(integer_data, out, pos);
+                case i16:     return _serialize_int_into(integer_data, out, pos);
+                case i32:     return _serialize_int_into(integer_data, out, pos);
+                case i64:     return _serialize_int_into(integer_data, out, pos);
+                case int:     return _serialize_int_into(integer_data, out, pos);
+                case u8:      return _serialize_int_into(integer_data, out, pos);
+                case u16:     return _serialize_int_into(integer_data, out, pos);
+                case u32:     return _serialize_int_into(integer_data, out, pos);
+                case u64:     return _serialize_int_into(integer_data, out, pos);
+                case uint:    return _serialize_int_into(integer_data, out, pos);
+
+                case i16le:   return _serialize_int_into(integer_data, out, pos);
+                case i32le:   return _serialize_int_into(integer_data, out, pos);
+                case i64le:   return _serialize_int_into(integer_data, out, pos);
+                case u16le:   return _serialize_int_into(integer_data, out, pos);
+                case u32le:   return _serialize_int_into(integer_data, out, pos);
+                case u64le:   return _serialize_int_into(integer_data, out, pos);
+
+                case i16be:   return _serialize_int_into(integer_data, out, pos);
+                case i32be:   return _serialize_int_into(integer_data, out, pos);
+                case i64be:   return _serialize_int_into(integer_data, out, pos);
+                case u16be:   return _serialize_int_into(integer_data, out, pos);
+                case u32be:   return _serialize_int_into(integer_data, out, pos);
+                case u64be:   return _serialize_int_into(integer_data, out, pos);
+            }
+            return .InvalidType;
+
+        case runtime.Type_Info_Rune:
+            return _serialize_int_into(cast(i32)base_data.(rune), out, pos);
+
+        case runtime.Type_Info_Float:
+            return _serialize_float_into(base_data, out, pos);
+
+        case runtime.Type_Info_String:
+            switch string_data in base_data {
+                case string:  return _serialize_string_into(string_data, out, pos);
+                case cstring: return _serialize_string_into(string(string_data), out, pos);
+            }
+
+        case runtime.Type_Info_Boolean:
+            return _serialize_int_into(base_data.(bool) == true ? u8(1) : u8(0), out, pos);
+
+        case runtime.Type_Info_Pointer:
+            if base_data.data == nil do return .None;
+            return _serialize_into(any { base_data.data, v.elem.id }, out, pos);
+
+        case runtime.Type_Info_Multi_Pointer:
+            if base_data.data == nil do return .None;
+            return _serialize_into(any { base_data.data, v.elem.id }, out, pos);
+
+        case runtime.Type_Info_Array:
+            return _serialize_indexable_into(base_data, v.count, out, pos);
+
+        case runtime.Type_Info_Enumerated_Array:
+            return _serialize_enum_array_into(base_data, v, out, pos);
+
+        case runtime.Type_Info_Dynamic_Array:
+            dyn_arr := cast(^runtime.Raw_Dynamic_Array)base_data.data;
+            return _serialize_indexable_into(base_data, dyn_arr.len, out, pos);
+
+        case runtime.Type_Info_Slice:
+            slice := cast(^runtime.Raw_Slice)base_data.data;
+            return _serialize_indexable_into(base_data, slice.len, out, pos);
+
+        case runtime.Type_Info_Struct:
+            return _serialize_struct_into(base_data, v, out, pos);
+
+        case runtime.Type_Info_Enum:
+            return _serialize_into({ base_data.data, v.base.id }, out, pos);
+
+        case:
+            return .InvalidType;
+    }
+    return .UnknownError;
+}
+
+/**
+ * @brief single-pass variant of 'serialize' which writes the binary form of "data" straight into "out", no intermediate buffers are allocated
+ * @note produces exactly the same bytes as 'serialize'; use 'marshall_serialized_size' to size "out" upfront
+ * @return number of bytes written into "out"; .BufferOverflow if "out" is too small
+ */
+serialize_into :: proc(data: any, out: []byte) -> (written: int, err: Marshall_Error) {
+    err = _serialize_into(data, out, &written);
+    return;
+}
+
+/**
+ * @brief sizes the output once (@see marshall_serialized_size) and serializes "data" into a single buffer taken from "allocator"
+ */
+serialize_alloc :: proc(data: any, allocator := context.allocator) -> (byte_data: []byte, err: Marshall_Error) {
+    size := marshall_serialized_size(data);
+    if size == -1 do return nil, .InvalidType;
+
+    alloc_err: mem.Allocator_Error;
+    byte_data, alloc_err = make([]byte, size, allocator);
+    if alloc_err != .None do return nil, .OutOfMemory;
+
+    written: int;
+    written, err = serialize_into(data, byte_data);
+    if err != .None {
+        delete(byte_data, allocator);
+        return nil, err;
+    }
+    return byte_data[:written], .None;
+}
+
+/**
+ * @brief arena-backed 'serialize_alloc', the whole serialized buffer is a single arena allocation
+ * @note the returned buffer is owned by the arena, do not 'delete' it, free the arena instead
+ */
+serialize_arena :: #force_inline proc(data: any, arena: ^mem.Arena) -> ([]byte, Marshall_Error) {
+    return serialize_alloc(data, mem.arena_allocator(arena));
+}
+/*! SERIALIZE INTO */
+
 @(private)
 _marshall_serialize_float_t :: #force_inline proc "contextless" (t: ^runtime.Type_Info, v: runtime.Type_Info_Float) -> int {
     if v.endianness == .Platform {
@@ -548,6 +947,7 @@ marshall_serialized_size_t :: proc "contextless" (t: ^runtime.Type_Info) -> int
  */
 marshall_serialized_size :: proc(data: any) -> int {
     _iterable_size :: #force_inline proc(data: any, count: int) -> int {
+        if _, elem := _indexable_raw_data(data); marshall_pod_size_t(elem) != -1 do return 8 + count * marshall_pod_size_t(elem);
         byte_data_len := 0;
         for it := 0; it < count; {
             val, _, fine := reflect.iterate_array(data, &it);
@@ -584,9 +984,10 @@ marshall_serialized_size :: proc(data: any) -> int {
 
     // todo: substitute the 'constant' - known size inside the _t version of this function!
     type_info := runtime.type_info_base(type_info_of(data.id));
+    base_data := any{data.data, type_info.id}; // distinct types would not match any of the cases below otherwise
     #partial switch v in type_info.variant {
         case runtime.Type_Info_Integer:
-            switch integer_data in data {
+            switch integer_data in base_data {
                 case i8:      return 1;
                 case i16:     return 2;
                 case i32:     return 4;
@@ -617,7 +1018,7 @@ marshall_serialized_size :: proc(data: any) -> int {
             return 4;
 
         case runtime.Type_Info_Float:
-            switch float_data in data {
+            switch float_data in base_data {
                 case f16:   return size_of(u8) /* sign */ + size_of(i8)    /* exp */ + size_of(u16le) /* mantissa */;
                 case f32:   return size_of(u8) /* sign */ + size_of(i16le) /* exp */ + size_of(u32le) /* mantissa */;
                 case f64:   return size_of(u8) /* sign */ + size_of(i32le) /* exp */ + size_of(u64le) /* mantissa */;
@@ -632,7 +1033,7 @@ marshall_serialized_size :: proc(data: any) -> int {
             }
 
         case runtime.Type_Info_String:
-            switch string_data in data {
+            switch string_data in base_data {
                 case string:  return 4 + len(string_data);
                 case cstring: return 4 + len(string_data);
             }
@@ -649,6 +1050,16 @@ marshall_serialized_size :: proc(data: any) -> int {
         case runtime.Type_Info_Array:
             return _iterable_size(data, v.count);
 
+        case runtime.Type_Info_Enumerated_Array:
+            if v.is_sparse do return -1;
+            byte_data_len := 0;
+            for it := 0; it < v.count; it += 1 {
+                elem_size := marshall_serialized_size(any { rawptr(uintptr(data.data) + uintptr(it * v.elem_size)), v.elem.id });
+                if elem_size == -1 do return -1;
+                byte_data_len += elem_size;
+            }
+            return 8 + byte_data_len;
+
         case runtime.Type_Info_Dynamic_Array:
             dyn_arr := cast(^runtime.Raw_Dynamic_Array)data.data;
             return _iterable_size(data, dyn_arr.len);
@@ -1029,6 +1440,16 @@ _interpret_bytes_to_strings :: #force_inline proc(
     return .None;
 }
 
+/**
+ * @brief copies the element block following the 8 byte indexable header straight into "val"
+ */
+@(private)
+_interpret_bytes_to_pod_block :: #force_inline proc(val: rawptr, block_size: int, data: []byte) -> Marshall_Error {
+    if 8 + block_size > len(data) do return .BufferOverflow;
+    if block_size > 0 do mem.copy_non_overlapping(val, raw_data(data[8:]), block_size);
+    return .None;
+}
+
 _interpret_bytes_to_indexable_default :: #force_inline proc(
     val: rawptr,
     elem_size: int,
@@ -1036,6 +1457,13 @@ _interpret_bytes_to_indexable_default :: #force_inline proc(
     len: int,
     data: []byte,
 ) -> (err: Marshall_Error) {
+    if pod_size := marshall_pod_size_t(type_info_of(elem_id)); pod_size == elem_size {
+        _interpret_bytes_to_pod_block(val, len * pod_size, data) or_return;
+        return .None;
+    }
+    if marshall_float_block_size_t(type_info_of(elem_id)) != -1 {
+        return _deserialize_float_block(type_info_of(elem_id), val, len, data);
+    }
     byte_elem_size := marshall_serialized_size_t(type_info_of(elem_id));
     if byte_elem_size == -1 do return .UnknownError;
     for i in 0..<len {
@@ -1071,6 +1499,9 @@ interpret_bytes_to_array :: proc(val: any, info: runtime.Type_Info_Array, data:
 
 interpret_bytes_to_enum_array :: #force_inline proc(val: any, info: runtime.Type_Info_Enumerated_Array, data: []byte) -> (err: Marshall_Error) {
     enum_array := val.data;
+    if pod_size := marshall_pod_size_t(info.elem); pod_size == info.elem_size {
+        return _interpret_bytes_to_pod_block(enum_array, info.count * pod_size, data);
+    }
     elem_size := marshall_serialized_size_t(info.elem);
     data_offset := 8;
 
@@ -1138,6 +1569,12 @@ interpret_bytes_to_slice :: proc(val: any, info: runtime.Type_Info_Slice, data:
             return;
 
         case:
+            if pod_size := marshall_pod_size_t(info.elem); pod_size == info.elem_size {
+                return _interpret_bytes_to_pod_block(slice.data, slice.len * pod_size, data);
+            }
+            if marshall_float_block_size_t(info.elem) != -1 {
+                return _deserialize_float_block(info.elem, slice.data, slice.len, data);
+            }
             elem_size := marshall_deserialized_size(type_info_of(info.elem.id), data[8:]) or_return;
             if elem_size == -1 do return .UnknownError; // this should not happen since here should end up only types which are arbitrary and supported
             for i := 0; i < slice.len; i += 1 {
@@ -1191,6 +1628,12 @@ interpret_bytes_to_dyn_array :: proc(val: any, info: runtime.Type_Info_Dynamic_A
 
         // default
         case:
+            if pod_size := marshall_pod_size_t(info.elem); pod_size == info.elem_size {
+                return _interpret_bytes_to_pod_block(dyn_arr.data, dyn_arr.len * pod_size, data);
+            }
+            if marshall_float_block_size_t(info.elem) != -1 {
+                return _deserialize_float_block(info.elem, dyn_arr.data, dyn_arr.len, data);
+            }
             elem_size := marshall_deserialized_size(type_info_of(info.elem.id), data[8:]) or_return;
             if elem_size == -1 do return .UnknownError; // this should not happen since here should end up only types which are arbitrary and supported
             for i := 0; i < dyn_arr.len; i += 1 {
@@ -1483,13 +1926,28 @@ marshall_write :: #force_inline proc(data: $T, path: string) -> Marshall_Error {
 }
 /**
  * @brief this functions writes binary data of any type "T" using binary.Writer, type reflection ensures that pointers and arrays/multi-pointers are written correctly
+ * @note indexables of plain integers are written as the header followed by the element memory, without going through 'serialize' at all
  */
 marshall_write_explicit :: proc(data: $T, writer: ^binary.Writer) -> (err: Marshall_Error) {
-    binary_data := serialize(data) or_return; // automatically assume "hideous" types
-    defer delete(binary_data);
-    // fmt.printf("%v\n", string(binary_data));
-    binary.write_bytes(writer, binary_data);
-    return;
+    E :: intrinsics.type_elem_type(T);
+    POD_INDEXABLE :: (intrinsics.type_is_array(T) || intrinsics.type_is_slice(T) || intrinsics.type_is_dynamic_array(T)) &&
+        intrinsics.type_is_integer(E) && size_of(E) <= 8 && E != uintptr; // compile time counterpart of 'marshall_pod_size_t'
+    when POD_INDEXABLE {
+        data := data;
+        elements := mem.slice_to_bytes(data[:]);
+        if len(data) > 1 << (size_of(u32) * 8) do return .ArrayTooLong;
+        header: [8]byte;
+        interpret_int_data((u64(len(data)) << 32) | u64(len(elements) + 8), header[:]);
+        binary.write_bytes(writer, header[:]);
+        binary.write_bytes(writer, elements);
+        return;
+    } else {
+        binary_data := serialize_alloc(data) or_return; // automatically assume "hideous" types
+        defer delete(binary_data);
+        // fmt.printf("%v\n", string(binary_data));
+        binary.write_bytes(writer, binary_data);
+        return;
+    }
 }
 
 marshall_read :: proc($T: typeid, path: string) -> (T, Marshall_Error) {
@@ -1500,6 +1958,24 @@ marshall_read :: proc($T: typeid, path: string) -> (T, Marshall_Error) {
 }
 marshall_read_explicit :: proc($T: typeid, reader: ^binary.Reader) -> (T, Marshall_Error) {
     val: T;
-    err := deserialize(val, reader.buffer);
-    return val, err;
-}
\ No newline at end of file
+    E :: intrinsics.type_elem_type(T);
+    POD_INDEXABLE :: (intrinsics.type_is_array(T) || intrinsics.type_is_slice(T) || intrinsics.type_is_dynamic_array(T)) &&
+        intrinsics.type_is_integer(E) && size_of(E) <= 8 && E != uintptr;
+    when POD_INDEXABLE {
+        if len(reader.buffer) < 8 do return val, .BufferOverflow;
+        special_size: u64 = 0;
+        interpret_bytes_to_int_data(special_size, reader.buffer[:8]);
+        count, byte_size := int(special_size >> 32), int(special_size & 0x00000000FFFFFFFF);
+        if byte_size - 8 != count * size_of(E) do return val, .ArraySizeMismatch;
+        when intrinsics.type_is_array(T) {
+            if count != len(T) do return val, .ArraySizeMismatch;
+        } else {
+            val = make(T, count);
+        }
+        err := _interpret_bytes_to_pod_block(raw_data(val[:]), byte_size - 8, reader.buffer);
+        return val, err;
+    } else {
+        err := deserialize(val, reader.buffer);
+        return val, err;
+    }
+}
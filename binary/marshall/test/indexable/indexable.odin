@@ -67,6 +67,26 @@ run_slices :: proc() {
         });
         delete(slice);
     }
+    // floats (batch loop)
+    {
+        slice := make([]f32, 1000);
+        for &v in slice do v = (rand.float32() - 0.5) * 1e6;
+        slice[0], slice[1], slice[2] = 0, -1.5, 1e-40; // zero, negative, subnormal
+        test_slices(slice, proc(s1, s2: []f32) {
+            assert(len(s1) == len(s2));
+            for val, idx in s1 do fmt.assertf(val == s2[idx], "Values do not match at [%v]: %v :: %v\n", idx, val, s2[idx]);
+        });
+        delete(slice);
+    }
+    {
+        slice := make([]f64, 1000);
+        for &v in slice do v = (rand.float64() - 0.5) * 1e12;
+        test_slices(slice, proc(s1, s2: []f64) {
+            assert(len(s1) == len(s2));
+            for val, idx in s1 do fmt.assertf(val == s2[idx], "Values do not match at [%v]: %v :: %v\n", idx, val, s2[idx]);
+        });
+        delete(slice);
+    }
     {
         slice := make([]int, 0);
         test_slices(slice, proc(s1, s2: []int) {
@@ -46,6 +46,17 @@ run :: proc() {
             }
             serialized, err := marshall.serialize(my_struct);
             fmt.assertf(err == .None, "\x1b[33mSerialization\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+            defer delete(serialized);
+            {
+                // single-pass serialization has to produce exactly the same bytes
+                serialized_into := make([]byte, marshall.marshall_serialized_size(my_struct));
+                defer delete(serialized_into);
+                written: int;
+                written, err = marshall.serialize_into(my_struct, serialized_into);
+                fmt.assertf(err == .None, "\x1b[33mSerialization (into)\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+                fmt.assertf(written == len(serialized), "Sizes do not match: %v[serialize_into] :: %v[serialize]\n", written, len(serialized));
+                for b, i in serialized do fmt.assertf(b == serialized_into[i], "Bytes do not match at [%v]: %v :: %v\n", i, b, serialized_into[i]);
+            }
             my_struct_deserialized: Struct;
             err = marshall.deserialize(my_struct_deserialized, serialized);
             fmt.assertf(err == .None, "\x1b[34mDeserialization\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
@@ -10,6 +10,7 @@ import ptr_test         "ptr"
 import rune_test        "rune"
 import string_test      "string"
 import struct_test      "struct"
+import view_test        "view"
 
 main :: proc() {
     bool_test.run();
@@ -21,4 +22,5 @@ main :: proc() {
     rune_test.run();
     string_test.run();
     struct_test.run();
+    view_test.run();
 }
\ No newline at end of file
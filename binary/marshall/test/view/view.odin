@@ -0,0 +1,142 @@
+package view_test
+
+import "core:fmt"
+import "core:os"
+import win32 "core:sys/windows"
+
+import "nexa_external:binary/marshall"
+
+foreign import psapi "system:Psapi.lib"
+
+PROCESS_MEMORY_COUNTERS :: struct {
+    cb:                         u32,
+    PageFaultCount:             u32,
+    PeakWorkingSetSize:         uint,
+    WorkingSetSize:             uint,
+    QuotaPeakPagedPoolUsage:    uint,
+    QuotaPagedPoolUsage:        uint,
+    QuotaPeakNonPagedPoolUsage: uint,
+    QuotaNonPagedPoolUsage:     uint,
+    PagefileUsage:              uint,
+    PeakPagefileUsage:          uint,
+}
+
+@(default_calling_convention="system")
+foreign psapi {
+    GetProcessMemoryInfo :: proc(process: win32.HANDLE, counters: ^PROCESS_MEMORY_COUNTERS, cb: u32) -> win32.BOOL ---
+}
+
+/**
+ * @brief page faults and working set of the process, the marshall package (and so this test) is Windows only
+ * @note 'binary.load_mapped' itself maps on Linux and Darwin as well (mmap_linux.odin, mmap_darwin.odin)
+ */
+memory_counters :: proc() -> (counters: PROCESS_MEMORY_COUNTERS) {
+    counters.cb = size_of(PROCESS_MEMORY_COUNTERS);
+    assert(GetProcessMemoryInfo(win32.GetCurrentProcess(), &counters, counters.cb) == true);
+    return;
+}
+
+View_Test_Header :: struct {
+    version: u32,
+    name:    string,
+}
+
+View_Test_Bundle :: struct {
+    header:   View_Test_Header  "NexaTag_Marshallable",
+    label:    string            "NexaTag_Marshallable",
+    payload:  []u32             "NexaTag_Marshallable",
+    vertices: []i64             "NexaTag_Marshallable",
+}
+
+VIEW_TEST_FILE     :: "view_test.dat";
+VIEW_TEST_ELEMENTS :: 1 << 24; // 64MB of u32 + 128MB of i64
+
+/** @brief scrambled but reproducible, so that the viewed payload can be checked without a copy of it */
+payload_value :: #force_inline proc "contextless" (i: int) -> u32 {
+    return u32(i) * 2654435761;
+}
+
+run :: proc() {
+    fmt.println("\nBeginning [VIEW]");
+    fmt.println("-----------------------------");
+
+    {
+        bundle := View_Test_Bundle {
+            header = { version = 7, name = "bundle", },
+            label = "view_test_bundle",
+            payload = make([]u32, VIEW_TEST_ELEMENTS),
+            vertices = make([]i64, VIEW_TEST_ELEMENTS),
+        };
+        defer {
+            delete(bundle.payload);
+            delete(bundle.vertices);
+        }
+        for &p, i in bundle.payload do p = payload_value(i);
+        for &v, i in bundle.vertices do v = i64(i);
+        err := marshall.marshall_write(bundle, VIEW_TEST_FILE);
+        fmt.assertf(err == .None, "\x1b[33mmarshall_write\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+    }
+    defer os.remove(VIEW_TEST_FILE);
+
+    // whole file read and decoded, only the header is needed though
+    {
+        before := memory_counters();
+        bundle, err := marshall.marshall_read(View_Test_Bundle, VIEW_TEST_FILE);
+        fmt.assertf(err == .None, "\x1b[34mmarshall_read\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+        after := memory_counters();
+        defer {
+            delete(bundle.header.name);
+            delete(bundle.label);
+            delete(bundle.payload);
+            delete(bundle.vertices);
+        }
+        fmt.assertf(bundle.header.version == 7 && bundle.header.name == "bundle", "Values do not match! %v\n", bundle.header);
+        fmt.printf(
+            "\tmarshall_read: %v page faults, %v KB working set\n",
+            after.PageFaultCount - before.PageFaultCount, (after.WorkingSetSize - before.WorkingSetSize) / 1024,
+        );
+    }
+
+    // mapped, only the accessed fields are decoded
+    {
+        before := memory_counters();
+        view, err := marshall.marshall_view(View_Test_Bundle, VIEW_TEST_FILE);
+        fmt.assertf(err == .None, "\x1b[34mmarshall_view\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+        defer marshall.dump_view(&view);
+
+        header: View_Test_Header;
+        header, err = marshall.view_field(&view, "header");
+        fmt.assertf(err == .None, "\x1b[34mview_field\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+        fmt.assertf(header.version == 7 && header.name == "bundle", "Values do not match! %v\n", header);
+        after := memory_counters();
+        fmt.printf(
+            "\tmarshall_view: %v page faults, %v KB working set\n",
+            after.PageFaultCount - before.PageFaultCount, (after.WorkingSetSize - before.WorkingSetSize) / 1024,
+        );
+
+        // slices (aliased when aligned, copied otherwise) have to see exactly what has been written
+        payload: []u32;
+        payload, err = marshall.view_field(&view, "payload");
+        fmt.assertf(err == .None, "\x1b[34mview_field\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+        defer if !marshall.view_aliases(&view, raw_data(payload)) do delete(payload);
+        fmt.assertf(len(payload) == VIEW_TEST_ELEMENTS, "Sizes do not match: %v :: %v\n", len(payload), VIEW_TEST_ELEMENTS);
+        fmt.assertf(uintptr(raw_data(payload)) % align_of(u32) == 0, "Misaligned payload: %p\n", raw_data(payload));
+        for p, i in payload do fmt.assertf(p == payload_value(i), "Values do not match at [%v]: %v\n", i, p);
+
+        vertices: []i64;
+        vertices, err = marshall.view_field(&view, "vertices");
+        fmt.assertf(err == .None, "\x1b[34mview_field\x1b[0m \x1b[31mfailed\x1b[0m with error: \x1b[31m%v\x1b[0m\n", err);
+        defer if !marshall.view_aliases(&view, raw_data(vertices)) do delete(vertices);
+        fmt.assertf(len(vertices) == VIEW_TEST_ELEMENTS, "Sizes do not match: %v :: %v\n", len(vertices), VIEW_TEST_ELEMENTS);
+        fmt.assertf(uintptr(raw_data(vertices)) % align_of(i64) == 0, "Misaligned vertices: %p\n", raw_data(vertices));
+        for v, i in vertices do fmt.assertf(v == i64(i), "Values do not match at [%v]: %v\n", i, v);
+
+        label: string;
+        label, err = marshall.view_field(&view, "label");
+        fmt.assertf(err == .None && label == "view_test_bundle", "Values do not match! %v (%v)\n", label, err);
+    }
+
+    fmt.println("\t\x1b[32mPassed...\x1b[0m view");
+    fmt.println("-----------------------------");
+    fmt.println("Ending [VIEW]\n");
+}
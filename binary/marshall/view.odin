@@ -0,0 +1,194 @@
+//+build windows
+package marshall
+
+import "base:runtime"
+import "base:intrinsics"
+
+import binary "../"
+
+/**
+ * @brief one top-level marshallable field of the viewed struct
+ */
+View_Field :: struct {
+    name:  string,
+    id:    typeid,
+    bytes: []byte, // serialized form of the field inside of the mapped file
+}
+
+/**
+ * @brief read-only view of a file written by 'marshall_write', the file is memory mapped and decoded only where it is accessed
+ * @note strings and slices of POD elements decoded from the view alias the mapped bytes: they must not be deleted/modified and are valid only until 'dump_view'
+ * @note everything else (dynamic arrays, cstrings, slices of non-POD elements, POD slices whose bytes are not aligned for their element) is allocated
+ *       exactly as 'deserialize' does and is owned by the caller (@see view_aliases)
+ */
+View :: struct($T: typeid) {
+    reader: ^binary.Reader,
+    fields: []View_Field, // offset table of T's fields, only filled when T is a struct
+}
+
+/**
+ * @brief maps the file at "path" and, for structs, builds the offset table of their fields without decoding any of them
+ */
+marshall_view :: proc($T: typeid, path: string) -> (view: View(T), err: Marshall_Error) {
+    view.reader = new(binary.Reader);
+    if !binary.load_mapped(view.reader, path) {
+        free(view.reader);
+        return {}, .ReadError;
+    }
+    when intrinsics.type_is_struct(T) {
+        view.fields, err = _view_offset_table(type_info_of(T), view.reader.buffer);
+        if err != .None {
+            dump_view(&view);
+            return {}, err;
+        }
+    }
+    return;
+}
+
+/**
+ * @return whether "data" (of a decoded string or slice) points into the mapped file, i.e. it must not be deleted
+ */
+view_aliases :: #force_inline proc "contextless" (view: ^View($T), data: rawptr) -> bool {
+    begin := uintptr(raw_data(view.reader.buffer));
+    return uintptr(data) >= begin && uintptr(data) < begin + uintptr(len(view.reader.buffer));
+}
+
+dump_view :: proc(view: ^View($T)) {
+    delete(view.fields);
+    binary.dump_reader(view.reader);
+    free(view.reader);
+    view^ = {};
+}
+
+/**
+ * @brief decodes the whole viewed value
+ */
+view_value :: proc(view: ^View($T)) -> (val: T, err: Marshall_Error) {
+    err = deserialize_view(val, view.reader.buffer);
+    return;
+}
+
+/**
+ * @brief lazily decodes a single field of the viewed struct, bytes of the other fields are never touched
+ */
+view_field :: proc(view: ^View($T), $name: string) -> (val: intrinsics.type_field_type(T, name), err: Marshall_Error)
+    where intrinsics.type_is_struct(T)
+{
+    for field in view.fields {
+        if field.name == name {
+            // nested structs are written whole (tagged or not), as 'interpret_bytes_to_struct' reads them
+            when intrinsics.type_is_struct(type_of(val)) {
+                struct_info := runtime.type_info_base(type_info_of(type_of(val))).variant.(runtime.Type_Info_Struct);
+                err = _deserialize_view_struct(val, struct_info, field.bytes, true);
+            } else {
+                err = deserialize_view(val, field.bytes);
+            }
+            return;
+        }
+    }
+    return val, .TypeMismatch; // field is not tagged as marshallable
+}
+
+@(private)
+_view_offset_table :: proc(t: ^runtime.Type_Info, data: []byte) -> (fields: []View_Field, err: Marshall_Error) {
+    v := runtime.type_info_base(t).variant.(runtime.Type_Info_Struct);
+    if v.is_raw_union do return nil, .StructIsRawUnion;
+
+    table := make([dynamic]View_Field);
+    defer if err != .None do delete(table);
+
+    byte_prev_offset := size_of(u32);
+    for _, index in v.offsets {
+        if v.tags[index] != "NexaTag_Marshallable" do continue;
+        if byte_prev_offset >= len(data) do return nil, .BufferOverflow;
+
+        byte_offset: int;
+        if type_is_struct(v.types[index]) {
+            byte_offset = _struct_field_size_deduction(
+                runtime.type_info_base(v.types[index]).variant.(runtime.Type_Info_Struct),
+                data[byte_prev_offset:],
+            ) or_return;
+        } else {
+            byte_offset = marshall_deserialized_size(
+                runtime.type_info_base(v.types[index]),
+                data[byte_prev_offset:],
+            ) or_return;
+        }
+        if byte_offset < 0 do return nil, .InvalidType;
+        if byte_prev_offset + byte_offset > len(data) do return nil, .BufferOverflow;
+
+        append(&table, View_Field {
+            name  = v.names[index],
+            id    = v.types[index].id,
+            bytes = data[byte_prev_offset : byte_prev_offset + byte_offset],
+        });
+        byte_prev_offset += byte_offset;
+    }
+    return table[:], .None;
+}
+
+@(private)
+_deserialize_view_struct :: proc(val: any, v: runtime.Type_Info_Struct, data: []byte, recurrent := false) -> Marshall_Error {
+    if v.is_raw_union do return .StructIsRawUnion;
+
+    byte_prev_offset: int = size_of(u32);
+    for offset, index in v.offsets {
+        if v.tags[index] == "NexaTag_Marshallable" || recurrent {
+            field := any {
+                data = rawptr(uintptr(val.data) + offset),
+                id = v.types[index].id,
+            };
+            byte_offset: int;
+            if type_is_struct(v.types[index]) {
+                struct_info := runtime.type_info_base(v.types[index]).variant.(runtime.Type_Info_Struct);
+                byte_offset = _struct_field_size_deduction(struct_info, data[byte_prev_offset:]) or_return;
+                if byte_offset < 0 do return .InvalidType;
+                _deserialize_view_struct(field, struct_info, data[byte_prev_offset : byte_prev_offset + byte_offset], true) or_return;
+            } else {
+                byte_offset = marshall_deserialized_size(runtime.type_info_base(v.types[index]), data[byte_prev_offset:]) or_return;
+                if byte_offset < 0 do return .InvalidType;
+                deserialize_view(field, data[byte_prev_offset : byte_prev_offset + byte_offset]) or_return;
+            }
+            byte_prev_offset += byte_offset;
+        }
+    }
+    return .None;
+}
+
+/**
+ * @brief 'deserialize' which does not copy: strings and slices of POD elements (@see marshall_pod_size_t) point straight into "data"
+ * @note a POD slice is aliased only when its bytes are aligned for its element type (the serialized layout packs fields without padding), it is copied otherwise
+ * @note the result is valid only as long as "data" is; types which cannot alias fall back to 'deserialize'
+ */
+deserialize_view :: proc(val: any, data: []byte) -> Marshall_Error {
+    type_info := runtime.type_info_base(type_info_of(val.id));
+
+    #partial switch v in type_info.variant {
+        case runtime.Type_Info_String:
+            if v.is_cstring do break; // needs its null terminator, has to be copied
+            if len(data) < size_of(u32) do return .BufferOverflow;
+            size: u32 = 0;
+            interpret_bytes_to_int_data(size, data[:size_of(u32)]) or_return;
+            if int(size) != len(data) - size_of(u32) do return .StringBufferSizeMismatch;
+            (cast(^string)val.data)^ = string(data[size_of(u32):]);
+            return .None;
+
+        case runtime.Type_Info_Slice:
+            pod_size := marshall_pod_size_t(v.elem);
+            if pod_size == -1 || pod_size != v.elem_size do break;
+            if len(data) < 8 do return .BufferOverflow;
+            special_size: u64 = 0;
+            interpret_bytes_to_int_data(special_size, data[:8]) or_return;
+            count := int(special_size >> 32);
+            if 8 + count * pod_size > len(data) do return .BufferOverflow;
+            if uintptr(raw_data(data[8:])) % uintptr(v.elem.align) != 0 do break; // a misaligned typed (or vectorized) access is undefined
+            slice := cast(^runtime.Raw_Slice)val.data;
+            slice.data = raw_data(data[8:]);
+            slice.len = count;
+            return .None;
+
+        case runtime.Type_Info_Struct:
+            return _deserialize_view_struct(val, v, data);
+    }
+    return deserialize(val, data);
+}
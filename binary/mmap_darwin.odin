@@ -0,0 +1,30 @@
+package binary
+
+import "core:os"
+import "core:sys/posix"
+
+Mapping :: struct {
+    data: rawptr,
+    size: uint,
+}
+
+_map_file :: proc(fname: string) -> (buffer: BinaryBuffer, mapping: Mapping, ok: bool) {
+    fd, err := os.open(fname, os.O_RDONLY);
+    if err != os.ERROR_NONE do return nil, {}, false;
+    defer os.close(fd); // the mapping keeps its own reference to the file
+
+    size, serr := os.file_size(fd);
+    if serr != os.ERROR_NONE do return nil, {}, false;
+    if size == 0 do return nil, {}, true; // empty files cannot be mapped
+
+    data := posix.mmap(nil, uint(size), {.READ}, {.PRIVATE}, posix.FD(fd), 0);
+    if data == posix.MAP_FAILED do return nil, {}, false;
+
+    mapping = { data, uint(size) };
+    return ([^]byte)(data)[:size], mapping, true;
+}
+
+_unmap_file :: proc(mapping: ^Mapping) {
+    posix.munmap(mapping.data, mapping.size);
+    mapping^ = {};
+}
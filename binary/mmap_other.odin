@@ -0,0 +1,21 @@
+//+build !linux !darwin !windows
+package binary
+
+import "core:os"
+
+/**
+ * @brief no memory mapping on this target, 'load_mapped' reads the whole file instead (Mapping.data stays nil, so 'dump_reader' frees the buffer)
+ */
+Mapping :: struct {
+    data: rawptr,
+    size: uint,
+}
+
+_map_file :: proc(fname: string) -> (buffer: BinaryBuffer, mapping: Mapping, ok: bool) {
+    buffer, ok = os.read_entire_file_from_filename(fname);
+    return buffer, {}, ok;
+}
+
+_unmap_file :: proc(mapping: ^Mapping) {
+    mapping^ = {};
+}
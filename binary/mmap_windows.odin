@@ -0,0 +1,51 @@
+package binary
+
+import win32 "core:sys/windows"
+
+Mapping :: struct {
+    file: win32.HANDLE,
+    view: win32.HANDLE,
+    data: rawptr,
+}
+
+_map_file :: proc(fname: string) -> (buffer: BinaryBuffer, mapping: Mapping, ok: bool) {
+    mapping.file = win32.CreateFileW(
+        win32.utf8_to_wstring(fname),
+        win32.GENERIC_READ,
+        win32.FILE_SHARE_READ,
+        nil,
+        win32.OPEN_EXISTING,
+        win32.FILE_ATTRIBUTE_NORMAL,
+        nil,
+    );
+    if mapping.file == win32.INVALID_HANDLE_VALUE do return nil, {}, false;
+
+    size: win32.LARGE_INTEGER;
+    if !win32.GetFileSizeEx(mapping.file, &size) || size == 0 {
+        // empty files cannot be mapped, there is nothing to read from them anyway
+        win32.CloseHandle(mapping.file);
+        return nil, {}, size == 0;
+    }
+
+    mapping.view = win32.CreateFileMappingW(mapping.file, nil, win32.PAGE_READONLY, 0, 0, nil);
+    if mapping.view == nil {
+        win32.CloseHandle(mapping.file);
+        return nil, {}, false;
+    }
+
+    mapping.data = win32.MapViewOfFile(mapping.view, win32.FILE_MAP_READ, 0, 0, 0);
+    if mapping.data == nil {
+        win32.CloseHandle(mapping.view);
+        win32.CloseHandle(mapping.file);
+        return nil, {}, false;
+    }
+
+    return ([^]byte)(mapping.data)[:size], mapping, true;
+}
+
+_unmap_file :: proc(mapping: ^Mapping) {
+    win32.UnmapViewOfFile(mapping.data);
+    win32.CloseHandle(mapping.view);
+    win32.CloseHandle(mapping.file);
+    mapping^ = {};
+}
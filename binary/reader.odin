@@ -9,16 +9,19 @@ POSITION_UNREAD :: u32(0);
 Reader :: struct #no_copy {
     buffer: BinaryBuffer,
     pos: u32,
+    mapping: Mapping, // only set when the buffer is a memory mapped file (@see load_mapped)
 }
 
 init_reader :: proc() -> Reader {
     return {
-        nil, POSITION_UNREAD,
+        nil, POSITION_UNREAD, {},
     };
 }
 
 dump_reader :: proc(using reader: ^Reader) {
-    if buffer != nil do delete(buffer);
+    if is_mapped(reader) do _unmap_file(&mapping);
+    else if buffer != nil do delete(buffer);
+    buffer = nil;
     pos = POSITION_UNREAD;
 }
 
@@ -31,6 +34,24 @@ load :: proc(using reader: ^Reader, fname: string) {
     assert(ok == true, "unable to read the file!");
 }
 
+/**
+ * maps the file into memory instead of reading it, pages are loaded by the OS only once they are touched
+ * @note Reader.buffer is read-only and stays valid until dump_reader/set/load
+ * @return false if the file could not be opened or mapped
+ */
+load_mapped :: proc(using reader: ^Reader, fname: string) -> bool {
+    dump_reader(reader);
+
+    ok := true;
+
+    buffer, mapping, ok = _map_file(fname);
+    return ok;
+}
+
+is_mapped :: #force_inline proc "contextless" (using reader: ^Reader) -> bool {
+    return mapping.data != nil;
+}
+
 peek :: proc(using reader: ^Reader) -> bool {
     return pos >= cast(u32)len(buffer);
 }
@@ -215,11 +236,10 @@ read_nbytes_static :: #force_inline proc(reader: ^Reader, $len: u32) -> (bytes:
 /* READER MOVE */
 set :: proc(using reader: ^Reader, new_buffer: BinaryBuffer) {
     /* check whether reader's buffer already exists, if yes -> free & rewrite, otherwise just set it */
-    if buffer == nil do buffer = new_buffer;
+    if buffer == nil && !is_mapped(reader) do buffer = new_buffer;
     else {
-        delete(buffer);
+        dump_reader(reader);
         buffer = new_buffer;
-        pos = POSITION_UNREAD;
     }
 }
 
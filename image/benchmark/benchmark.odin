@@ -0,0 +1,162 @@
+package main
+
+import "core:fmt"
+import "core:os"
+import "core:thread"
+import "core:time"
+import "core:math/rand"
+
+import image "../../image"
+import bmp   "../bmp"
+
+BENCHMARK_SIZES      :: [?]image.ImageSize { { 3840, 2160 }, { 7680, 4320 } };
+BENCHMARK_ITERATIONS :: 5;
+
+/**
+ * @brief the source images and preallocated destinations, so that the timings do not include page faults of fresh allocations
+ * @note 'to_normalized' allocates its result, its timings do include them
+ */
+Images :: struct {
+    size:  image.ImageSize,
+    bgr8:  image.ImageBGR8,
+    rgba8: image.ImageRGBA8,
+    bgr16: image.ImageBGR16,
+    bgr32: image.ImageBGR32,
+    rgb:   []u8,
+}
+
+Conversion :: struct {
+    name: string,
+    run:  proc(images: ^Images, thread_count: int, pool: ^thread.Pool),
+}
+
+CONVERSIONS := [?]Conversion {
+    { "BGR8 -> RGBA8",  proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) { image.convert_image(&rgba8, &bgr8, thread_count, pool); } },
+    { "RGBA8 -> BGR8",  proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) { image.convert_image(&bgr8, &rgba8, thread_count, pool); } },
+    { "BGR8 -> BGR16",  proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) { image.convert_image(&bgr16, &bgr8, thread_count, pool); } },
+    { "BGR16 -> BGR8",  proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) { image.convert_image(&bgr8, &bgr16, thread_count, pool); } },
+    { "BGR8 -> BGR32",  proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) { image.convert_image(&bgr32, &bgr8, thread_count, pool); } },
+    { "BGR32 -> BGR16", proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) { image.convert_image(&bgr16, &bgr32, thread_count, pool); } },
+    { "BGR8 -> RGB8",   proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) { image.convert_bgr8_to_rgb8(rgb, bgr8.data, thread_count, pool); } },
+    { "BGR8 -> unorm",  proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) {
+        normalized := image.to_normalized(&bgr8, thread_count, pool);
+        image.dump_normalized(&normalized);
+    } },
+    { "RGBA8 -> unorm", proc(using images: ^Images, thread_count: int, pool: ^thread.Pool) {
+        normalized := image.to_normalized(&rgba8, thread_count, pool);
+        image.dump_normalized(&normalized);
+    } },
+};
+
+init_images :: proc(size: image.ImageSize) -> (images: Images) {
+    pixels := int(size.x * size.y);
+    images.size  = size;
+    images.bgr8  = { size = size, data = make([]image.BGR8, pixels),  info = image.BGR_UUID  | (image.UINT8_UUID << 4),  };
+    images.rgba8 = { size = size, data = make([]image.RGBA8, pixels), info = image.RGBA_UUID | (image.UINT8_UUID << 4),  };
+    images.bgr16 = { size = size, data = make([]image.BGR16, pixels), info = image.BGR_UUID  | (image.UINT16_UUID << 4), };
+    images.bgr32 = { size = size, data = make([]image.BGR32, pixels), info = image.BGR_UUID  | (image.UINT32_UUID << 4), };
+    images.rgb   = make([]u8, 3 * pixels);
+    for &pixel in images.bgr8.data do pixel.b.data, pixel.g.data, pixel.r.data = u8(rand.uint32()), u8(rand.uint32()), u8(rand.uint32());
+    image.convert_image(&images.rgba8, &images.bgr8);
+    image.convert_image(&images.bgr16, &images.bgr8);
+    image.convert_image(&images.bgr32, &images.bgr8);
+    return;
+}
+
+dump_images :: proc(using images: ^Images) {
+    image.dump_image2(&bgr8);
+    image.dump_image2(&rgba8);
+    image.dump_image2(&bgr16);
+    image.dump_image2(&bgr32);
+    delete(rgb);
+}
+
+main :: proc() {
+    for size in BENCHMARK_SIZES {
+        images := init_images(size);
+        defer dump_images(&images);
+
+        benchmark_conversions(&images);
+        benchmark_bmp(&images);
+    }
+}
+
+/**
+ * @brief best of BENCHMARK_ITERATIONS runs per conversion and thread count, megapixels per second and the speedup over a single thread
+ * @note one pool per thread count is started before the timings and reused by every run (the calling thread is the last worker)
+ */
+benchmark_conversions :: proc(images: ^Images) {
+    megapixels := f64(images.size.x * images.size.y) / 1e6;
+    fmt.printf("Beginning [CONVERSION BENCHMARK] %vx%v (%.1f MP)\n", images.size.x, images.size.y, megapixels);
+    fmt.printf("-----------------------------\n");
+    fmt.printf("\t%-16s %-8s %12s %12s %8s\n", "conversion", "threads", "time [ms]", "MP/s", "speedup");
+
+    thread_counts := [?]int { 1, 2, 4, 8, os.processor_core_count() };
+    pools: [len(thread_counts)]thread.Pool;
+    for thread_count, i in thread_counts {
+        if thread_count <= 1 do continue;
+        thread.pool_init(&pools[i], context.allocator, thread_count - 1);
+        thread.pool_start(&pools[i]);
+    }
+    defer {
+        for thread_count, i in thread_counts {
+            if thread_count <= 1 do continue;
+            thread.pool_finish(&pools[i]);
+            thread.pool_destroy(&pools[i]);
+        }
+    }
+
+    for conversion in CONVERSIONS {
+        single: time.Duration;
+        for thread_count, t in thread_counts {
+            pool: ^thread.Pool = thread_count > 1 ? &pools[t] : nil;
+            best := max(time.Duration);
+            for _ in 0..<BENCHMARK_ITERATIONS {
+                start := time.tick_now();
+                conversion.run(images, thread_count, pool);
+                best = min(best, time.tick_since(start));
+            }
+            if thread_count == 1 do single = best;
+
+            fmt.printf(
+                "\t%-16s %-8v %12.3f %12.1f %8.2f\n",
+                conversion.name, thread_count,
+                time.duration_milliseconds(best),
+                megapixels / time.duration_seconds(best),
+                time.duration_seconds(single) / time.duration_seconds(best),
+            );
+        }
+    }
+}
+
+/**
+ * @brief whole file round trip through 'bmp_write_bgr' and 'bmp_read_bgr8' (a single write and a single read of the pixel array)
+ */
+benchmark_bmp :: proc(images: ^Images) {
+    BENCHMARK_FILE :: "benchmark.bmp";
+    megapixels := f64(images.size.x * images.size.y) / 1e6;
+    fmt.printf("\nBeginning [BMP BENCHMARK] %vx%v BGR8\n", images.size.x, images.size.y);
+    fmt.printf("-----------------------------\n");
+    fmt.printf("\t%-16s %12s %12s\n", "operation", "time [ms]", "MP/s");
+    defer os.remove(BENCHMARK_FILE);
+
+    {
+        start := time.tick_now();
+        err := bmp.bmp_write_bgr(&images.bgr8, BENCHMARK_FILE);
+        duration := time.tick_since(start);
+        assert(err == .E_NONE);
+        fmt.printf("\t%-16s %12.3f %12.1f\n", "bmp_write_bgr", time.duration_milliseconds(duration), megapixels / time.duration_seconds(duration));
+    }
+    {
+        start := time.tick_now();
+        img, err := bmp.bmp_read_bgr8(BENCHMARK_FILE);
+        duration := time.tick_since(start);
+        assert(err == .E_NONE);
+        defer image.dump_image2(&img);
+        for pixel, i in img.data {
+            expected := images.bgr8.data[i];
+            fmt.assertf(pixel.r.data == expected.r.data && pixel.g.data == expected.g.data && pixel.b.data == expected.b.data, "\x1b[31mbmp round trip differs at [%v]\x1b[0m\n", i);
+        }
+        fmt.printf("\t%-16s %12.3f %12.1f\n\n", "bmp_read_bgr8", time.duration_milliseconds(duration), megapixels / time.duration_seconds(duration));
+    }
+}
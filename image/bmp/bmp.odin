@@ -1,11 +1,13 @@
 package bmp
 
+import "base:intrinsics"
 import "core:io"
 import "core:os"
 import "core:mem"
 import "core:log"
 import "core:strings"
 import "core:math"
+import "core:simd"
 
 import "../../image"
 import "../utils"
@@ -135,7 +137,7 @@ bmp_write_auto :: proc(using img: ^image.RawImage, file_path: string) -> BMP_Wri
         }, size
     );
     defer delete(bmp_array);
-    return _bmp_write_data(writer, size.x, size.y, cast(u32)bit_depth/8, bmp_array[:]);
+    return _bmp_write_data(writer, bmp_array);
 }
 
 bmp_write_bgr :: proc(using img: ^image.Image2(image.BGR($PixelDataT)), file_path: string) -> (err: BMP_WriteError) {
@@ -168,8 +170,7 @@ bmp_write_bgr :: proc(using img: ^image.Image2(image.BGR($PixelDataT)), file_pat
     _bmp_write_dib(writer, init_dib(size, bit_depth));
     bmp_array := _bmp_data_convert8(data, size);
     defer delete(bmp_array);
-    // log.infof("\x1b[31m%v\x1b[0m", bmp_array);
-    return _bmp_write_data(writer, size.x, size.y, cast(u32)bit_depth / 8, bmp_array);
+    return _bmp_write_data(writer, bmp_array);
 }
 
 /*
@@ -189,7 +190,7 @@ bmp_write_bgr_palette :: proc(using img: ^image.ImageBGR8, palette: BMP_Palette(
 
     bmp_array := _bmp_data_convert8(data, size);
     defer delete(bmp_array);
-    _bmp_write_data(writer, bmp_array);
+    _ = _bmp_write_data(writer, bmp_array);
 }
 
 bmp_write_rgba :: proc() {
@@ -289,16 +290,34 @@ _bmp_write_dib :: #force_inline proc(writer: io.Writer, dib: bmpfile_dib_info) {
     utils.write_file_safe(writer, dib_array[:]);
 }
 
+/**
+ * @brief BGR(X) pixels to the rows of the bitmap (3 bytes per pixel, every row padded to 4 bytes), 8 bit pixels go through the vector kernel in parallel row tiles
+ * @return the whole pixel array of the file, written with a single call
+ */
 // @(private="file")
 //>>>NOTE: the $PixelDataT is here for convenience since we are working with raw_union(s), type conversions/deductions are not so easily procured
-_bmp_data_convert8 :: #force_inline proc(data_before: []image.BGR($PixelDataT), size: image.ImageSize) -> []u8 {
-    byte_array := make([]u8, size.x * size.y * 3);
-    for bgr, index in data_before {
-        byte_array[3 * index + 0] = cast(u8)bgr.r.data;
-        byte_array[3 * index + 1] = cast(u8)bgr.g.data;
-        byte_array[3 * index + 2] = cast(u8)bgr.b.data;
-    }
-    return byte_array;
+_bmp_data_convert8 :: proc(data_before: []image.BGR($PixelDataT), size: image.ImageSize) -> []u8 {
+    Job :: struct { rows: []u8, pixels: []image.BGR(PixelDataT), width, row_size_with_padding: int };
+    job := Job{ pixels = data_before, width = int(size.x), row_size_with_padding = _bmp_row_size(size.x, 3), };
+    job.rows = make([]u8, job.row_size_with_padding * int(size.y)); // zeroed, so the padding is already in place
+
+    image.parallel_tiles(int(size.y), max(1, image.row_tile_pixels(job.width) / max(1, job.width)), proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        for row in begin..<end {
+            dst := rows[row * row_size_with_padding : row * row_size_with_padding + 3 * width];
+            src := pixels[row * width : (row + 1) * width];
+            when PixelDataT == image.PixelData8 {
+                image.kernel_bgr8_to_rgb8(dst, src);
+            } else {
+                for bgr, index in src {
+                    dst[3 * index + 0] = cast(u8)bgr.r.data;
+                    dst[3 * index + 1] = cast(u8)bgr.g.data;
+                    dst[3 * index + 2] = cast(u8)bgr.b.data;
+                }
+            }
+        }
+    }, &job);
+    return job.rows;
 }
 
 @(private="file")
@@ -371,29 +390,22 @@ _bmp_data_convert32 :: #force_inline proc(data_before: []image.BGR32, size: imag
 
 @(private="file")
 @(require_results)
-_bmp_write_data :: #force_inline proc(writer: io.Writer, width: u32, height: u32, bytes_per_pixel: u32, data: []u8) -> BMP_WriteError {
-    row_size_with_padding := int((width * bytes_per_pixel + 3) / 4) * 4;
-    row_size_without_padding := width * bytes_per_pixel;
-
-    row_buffer := make([]u8, row_size_with_padding);
-    defer delete(row_buffer);
-
-    for i in 0..<height {
-        assert(copy_slice(row_buffer, data[i * row_size_without_padding : (i + 1) * row_size_without_padding]) == row_size_with_padding);
-
-        if row_size_with_padding > int(row_size_without_padding) do mem.zero_slice(row_buffer[row_size_without_padding:]);
-
-        len, err := io.write(writer, row_buffer);
-        if len != row_size_with_padding do return .E_WRITE_INSUFFICIENT_DATA;
-        if err != .None {
-            log.errorf("%v", err);
-            return .E_WRITE_FAILED;
-        }
+_bmp_write_data :: #force_inline proc(writer: io.Writer, data: []u8) -> BMP_WriteError {
+    written, err := io.write(writer, data);
+    if err != .None {
+        log.errorf("%v", err);
+        return .E_WRITE_FAILED;
     }
+    if written != len(data) do return .E_WRITE_INSUFFICIENT_DATA;
 
     return .E_NONE;
 }
 
+@(private="file")
+_bmp_row_size :: #force_inline proc "contextless" (width: u32, bytes_per_pixel: u32) -> int {
+    return int((width * bytes_per_pixel + 3) / 4) * 4;
+}
+
 @(private="file")
 BITMAP_DATA_SIZE :: #force_inline proc(width: i32, height: i32) -> u32 {
     return u32(((width * 3) + ((width * 3) % 4)) * height);
@@ -470,21 +482,20 @@ bmp_read_bgr8 :: proc(file_path: string) -> (img: image.ImageBGR8, err: BMP_Read
     _bmp_read_magic(reader) or_return;
     header := _bmp_read_header(reader, Header_ExpectedValues { BMP_OFFSET }) or_return;
     dib    := _bmp_read_dib(reader, DIB_ExpectedValues { 24 }) or_return;
-    data   := _bmp_read_data(reader, auto_cast dib.width, auto_cast dib.height, auto_cast dib.bits_per_pixel/8, Data_ExpectedValues { auto_cast BITMAP_DATA_SIZE(dib.width, dib.height) }) or_return;
-    defer delete(data);
+    if dib.bits_per_pixel != 24 do return {}, .E_READ_UNSUPPORTED_BIT_DEPTH;
 
     img.data = make([]image.BGR8, dib.width * dib.height);
     img.info = image.BGR_UUID | (image.UINT8_UUID << 4);
     img.size = image.IMAGE_SIZE(dib.width, dib.height);
-    copy_data_into_img :: proc(data: []u8, img: []image.BGR8) {
-        for i := 0; i < len(img); i += 1 {
-            img[i].r.data = data[i * 3 + 0];
-            img[i].g.data = data[i * 3 + 1];
-            img[i].b.data = data[i * 3 + 2];
-        }
+
+    // a row of the file (3 bytes per pixel, padded to 4 bytes) never takes more space than a row of the image (4 bytes per pixel),
+    // so the whole pixel array is read with one call straight into the image and widened in place
+    row_size_with_padding := _bmp_row_size(u32(dib.width), 3);
+    if err := _bmp_read_bulk(reader, (cast([^]u8)raw_data(img.data))[:row_size_with_padding * int(dib.height)]); err != .E_NONE {
+        delete(img.data);
+        return {}, err;
     }
-    copy_data_into_img(data[:], img.data[:]);
-    // log.infof("\x1b[33m%v\x1b[0m", data);
+    _bmp_expand_rows8(img.data, int(dib.width), int(dib.height), row_size_with_padding);
 
     return img, .E_NONE;
 }
@@ -605,28 +616,59 @@ Data_ExpectedValues :: struct {
 }
 
 @(private="file")
-_bmp_read_data :: proc(reader: io.Reader, width: u32, height: u32, bytes_per_pixel: u32, expected: Data_ExpectedValues) -> ([]u8, BMP_ReadError) {
+_bmp_read_bulk :: proc(reader: io.Reader, data: []u8) -> BMP_ReadError {
+    read, err := io.read_full(reader, data);
+    if err == .EOF || err == .Unexpected_EOF || read != len(data) do return .E_READ_UNEXPECTED_END_OF_FILE;
+    if err != .None {
+        log.errorf("%v", err);
+        return .E_READ_CORRUPTED_DATA;
+    }
+    return .E_NONE;
+}
 
-    row_size_with_padding := int((width * bytes_per_pixel + 3) / 4) * 4;
-    row_size_without_padding := width * bytes_per_pixel;
-
-    row_buffer := make([]u8, row_size_with_padding);
-    final_data := make([]u8, row_size_without_padding * height);
-    defer delete(row_buffer);
-
-    for i in 0..<height {
-        len, err := io.read(reader, row_buffer);
-        if len != row_size_with_padding {
-            delete(final_data);
-            return {}, .E_READ_UNEXPECTED_END_OF_FILE;
-        } 
-        if err != .None {
-            log.errorf("%v", err);
-            delete(final_data);
-            return {}, .E_READ_CORRUPTED_DATA;
+/**
+ * @brief widens the rows of the file (r, g, b bytes + padding) read to the beginning of "pixels" into the BGR(X) pixels, in place
+ * @note goes backwards: a pixel never lands before the bytes it was read from, so every write only hits bytes that were already consumed;
+ * for the same reason it cannot be split across threads, it is a single pass over memory that is still in the cache from the read anyway
+ */
+@(private="file")
+_bmp_expand_rows8 :: proc(pixels: []image.BGR8, width, height, row_size_with_padding: int) {
+    bytes := cast([^]u8)raw_data(pixels);
+    zero: #simd[16]u8;
+    for row := height - 1; row >= 0; row -= 1 {
+        src := row * row_size_with_padding;
+        dst := row * width;
+        x := width;
+        // 4 pixels per shuffle; the 16 byte load reads 4 bytes of the next (already converted) pixel which end up in the dropped lanes
+        #no_bounds_check for ; x >= 4 + width % 4; {
+            x -= 4;
+            v := intrinsics.unaligned_load(cast(^#simd[16]u8)&bytes[src + 3 * x]);
+            v  = simd.shuffle(v, zero, 2, 1, 0, 16, 5, 4, 3, 16, 8, 7, 6, 16, 11, 10, 9, 16);
+            intrinsics.unaligned_store(cast(^#simd[16]u8)&pixels[dst + x], v);
+        }
+        #no_bounds_check for x > 0 {
+            x -= 1;
+            r, g, b := bytes[src + 3 * x], bytes[src + 3 * x + 1], bytes[src + 3 * x + 2];
+            pixels[dst + x] = { b = { data = b, }, g = { data = g, }, r = { data = r, }, };
         }
-        copy_slice(final_data[i * row_size_without_padding:(i+1)*row_size_without_padding], row_buffer[:row_size_without_padding]);
     }
-    // log.errorf("Final slice: %v", row_buffer);
-    return final_data, .E_NONE;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief the whole pixel array read with a single call, the row padding is then squeezed out in place
+ */
+@(private="file")
+_bmp_read_data :: proc(reader: io.Reader, width: u32, height: u32, bytes_per_pixel: u32, expected: Data_ExpectedValues) -> ([]u8, BMP_ReadError) {
+    row_size_with_padding := _bmp_row_size(width, bytes_per_pixel);
+    row_size_without_padding := int(width * bytes_per_pixel);
+
+    final_data := make([]u8, row_size_with_padding * int(height));
+    if err := _bmp_read_bulk(reader, final_data); err != .E_NONE {
+        delete(final_data);
+        return {}, err;
+    }
+    if row_size_with_padding != row_size_without_padding {
+        for i in 1..<int(height) do copy(final_data[i * row_size_without_padding:], final_data[i * row_size_with_padding : i * row_size_with_padding + row_size_without_padding]);
+    }
+    return final_data[:row_size_without_padding * int(height)], .E_NONE;
+}
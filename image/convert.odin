@@ -0,0 +1,332 @@
+package image
+
+import "base:intrinsics"
+import "base:runtime"
+import "core:os"
+import "core:simd"
+import "core:thread"
+
+import "utils"
+
+/* CONVERSION ENGINE */
+/**
+ * @brief pixels converted by one task; images are split into tiles of whole rows holding at least this many pixels
+ * @note images smaller than one tile are converted on the calling thread, starting the pool would cost more than the conversion
+ */
+CONVERT_TILE_PIXELS :: 1 << 16;
+/**
+ * @brief samples per vector in the kernels (16 bytes for 8 bit samples, the compiler splits wider vectors into as many registers as the target has)
+ */
+SIMD_LANES :: 16;
+
+Tile_Kernel :: #type proc(data: rawptr, begin, end: int);
+
+@(private="file")
+Tile_Task :: struct {
+    kernel:     Tile_Kernel,
+    data:       rawptr,
+    begin, end: int,
+}
+
+@(private="file")
+_tile_task :: proc(task: thread.Task) {
+    using tile := cast(^Tile_Task)task.data;
+    kernel(data, begin, end);
+}
+
+/**
+ * @brief calls "kernel" over [0, count) split into tiles of "tile_size", tiles are spread across a thread pool
+ * @note "thread_count" of 0 picks the number of cores, 1 (or a single tile) runs everything on the calling thread
+ * @param pool already started pool the tiles run on (@see utils.pool_run_tasks), "thread_count" is then ignored; a pool is created for the call when nil
+ */
+parallel_tiles :: proc(count, tile_size: int, kernel: Tile_Kernel, data: rawptr, thread_count := 0, pool: ^thread.Pool = nil) {
+    if count <= 0 do return;
+    tile_size  := max(1, tile_size);
+    tile_count := (count + tile_size - 1) / tile_size;
+    thread_count := thread_count <= 0 ? os.processor_core_count() : thread_count;
+    if pool != nil do thread_count = len(pool.threads) + 1; // the calling thread works too
+    thread_count = min(thread_count, tile_count);
+    if thread_count <= 1 {
+        kernel(data, 0, count);
+        return;
+    }
+
+    tiles := make([]Tile_Task, tile_count);
+    defer delete(tiles);
+    for &tile, i in tiles do tile = { kernel, data, i * tile_size, min((i + 1) * tile_size, count) };
+
+    if pool != nil {
+        for &tile, i in tiles do thread.pool_add_task(pool, runtime.heap_allocator(), _tile_task, &tile, i);
+        utils.pool_run_tasks(pool);
+        return;
+    }
+    local_pool: thread.Pool;
+    thread.pool_init(&local_pool, runtime.heap_allocator(), thread_count);
+    defer thread.pool_destroy(&local_pool);
+    for &tile, i in tiles do thread.pool_add_task(&local_pool, runtime.heap_allocator(), _tile_task, &tile, i);
+    thread.pool_start(&local_pool);
+    thread.pool_finish(&local_pool);
+}
+
+/**
+ * @brief number of pixels in a tile of whole rows of an image "width" pixels wide
+ */
+row_tile_pixels :: #force_inline proc "contextless" (width: int) -> int {
+    width := max(1, width);
+    return max(1, CONVERT_TILE_PIXELS / width) * width;
+}
+/*! CONVERSION ENGINE */
+
+/* KERNELS */
+@(private="file")
+_splat :: #force_inline proc "contextless" ($V: typeid/#simd[$N]$E, value: E) -> V {
+    lanes: [N]E;
+    for &lane in lanes do lane = value;
+    return transmute(V)lanes;
+}
+
+/**
+ * @brief scales one unsigned sample to the full range of "D": widening replicates the bits (0xab -> 0xabab), narrowing keeps the upper bits
+ */
+rescale_sample :: #force_inline proc "contextless" ($D: typeid, value: $S) -> D where intrinsics.type_is_unsigned(D), intrinsics.type_is_unsigned(S) {
+    when size_of(D) > size_of(S) {
+        return D(value) * (max(D) / D(max(S)));
+    } else when size_of(D) < size_of(S) {
+        return D(value >> ((size_of(S) - size_of(D)) * 8));
+    } else {
+        return D(value);
+    }
+}
+
+/**
+ * @brief "rescale_sample" over whole slices of samples, SIMD_LANES at a time
+ */
+kernel_rescale_samples :: proc "contextless" (dst: []$D, src: []$S) where intrinsics.type_is_unsigned(D), intrinsics.type_is_unsigned(S) {
+    count := min(len(dst), len(src));
+    i := 0;
+    #no_bounds_check for ; i + SIMD_LANES <= count; i += SIMD_LANES {
+        v := intrinsics.unaligned_load(cast(^#simd[SIMD_LANES]S)&src[i]);
+        w: #simd[SIMD_LANES]D;
+        when size_of(D) > size_of(S) {
+            w = cast(#simd[SIMD_LANES]D)v * _splat(#simd[SIMD_LANES]D, max(D) / D(max(S)));
+        } else when size_of(D) < size_of(S) {
+            w = cast(#simd[SIMD_LANES]D)simd.shr(v, _splat(#simd[SIMD_LANES]S, (size_of(S) - size_of(D)) * 8));
+        } else {
+            w = transmute(#simd[SIMD_LANES]D)v;
+        }
+        intrinsics.unaligned_store(cast(^#simd[SIMD_LANES]D)&dst[i], w);
+    }
+    #no_bounds_check for ; i < count; i += 1 do dst[i] = rescale_sample(D, src[i]);
+}
+
+/**
+ * @brief unsigned samples to unorm (0..=1), multiplied by the reciprocal of the maximum instead of dividing every sample
+ */
+kernel_unorm_samples :: proc "contextless" (dst: []f32, src: []$S) where intrinsics.type_is_unsigned(S) {
+    SCALE :: f32(1) / f32(max(S));
+    count := min(len(dst), len(src));
+    i := 0;
+    scale := _splat(#simd[SIMD_LANES]f32, SCALE);
+    #no_bounds_check for ; i + SIMD_LANES <= count; i += SIMD_LANES {
+        v := intrinsics.unaligned_load(cast(^#simd[SIMD_LANES]S)&src[i]);
+        intrinsics.unaligned_store(cast(^#simd[SIMD_LANES]f32)&dst[i], cast(#simd[SIMD_LANES]f32)v * scale);
+    }
+    #no_bounds_check for ; i < count; i += 1 do dst[i] = f32(src[i]) * SCALE;
+}
+
+/**
+ * @brief swaps the r and b bytes of 4 byte pixels (BGRX8 <-> RGBA8) and ORs "alpha" into the 4th byte
+ * @note a pixel is handled as one little endian u32: b | g << 8 | r << 16 | x << 24, which turns the shuffle into shifts and masks
+ */
+@(private="file")
+_kernel_swap_rb8 :: #force_inline proc "contextless" (dst, src: []u32, alpha: u32) {
+    LANES :: SIMD_LANES / 2;
+    count := min(len(dst), len(src));
+    i := 0;
+    when ODIN_ENDIAN == .Little {
+        low   := _splat(#simd[LANES]u32, 0x0000ff);
+        green := _splat(#simd[LANES]u32, 0x00ff00);
+        shift := _splat(#simd[LANES]u32, 16);
+        a     := _splat(#simd[LANES]u32, alpha);
+        #no_bounds_check for ; i + LANES <= count; i += LANES {
+            p := intrinsics.unaligned_load(cast(^#simd[LANES]u32)&src[i]);
+            q := (simd.shr(p, shift) & low) | (p & green) | simd.shl(p & low, shift) | a;
+            intrinsics.unaligned_store(cast(^#simd[LANES]u32)&dst[i], q);
+        }
+    }
+    #no_bounds_check for ; i < count; i += 1 {
+        bytes := transmute([4]u8)src[i];
+        dst[i] = transmute(u32)[4]u8{ bytes[2], bytes[1], bytes[0], 0 } | alpha;
+    }
+}
+
+kernel_bgr8_to_rgba8 :: proc "contextless" (dst: []RGBA8, src: []BGR8) {
+    #assert(size_of(BGR8) == 4 && size_of(RGBA8) == 4);
+    _kernel_swap_rb8(transmute([]u32)dst, transmute([]u32)src, transmute(u32)[4]u8{ 0, 0, 0, 0xff });
+}
+
+kernel_rgba8_to_bgr8 :: proc "contextless" (dst: []BGR8, src: []RGBA8) {
+    _kernel_swap_rb8(transmute([]u32)dst, transmute([]u32)src, 0);
+}
+
+/**
+ * @brief BGR(X)8 pixels to tightly packed RGB bytes (png scanlines, bmp rows), 4 pixels per shuffle
+ * @note the vector store writes 16 bytes for the 12 it produces, so it stops while "dst" still has room for the 4 bytes of overhang
+ */
+kernel_bgr8_to_rgb8 :: proc "contextless" (dst: []u8, src: []BGR8) {
+    count := min(len(src), len(dst) / 3);
+    i := 0;
+    #no_bounds_check for ; i + 4 <= count && 3 * i + 16 <= len(dst); i += 4 {
+        v := intrinsics.unaligned_load(cast(^#simd[16]u8)&src[i]);
+        intrinsics.unaligned_store(cast(^#simd[16]u8)&dst[3 * i], swizzle(v, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 15, 15, 15, 15));
+    }
+    #no_bounds_check for ; i < count; i += 1 {
+        dst[3 * i + 0] = src[i].r.data;
+        dst[3 * i + 1] = src[i].g.data;
+        dst[3 * i + 2] = src[i].b.data;
+    }
+}
+/*! KERNELS */
+
+/* PIXEL CONVERSIONS */
+@(private="file")
+_samples :: #force_inline proc "contextless" ($SampleT: typeid, pixels: []$PixelT) -> []SampleT {
+    return (cast([^]SampleT)raw_data(pixels))[:len(pixels) * size_of(PixelT) / size_of(SampleT)];
+}
+
+/**
+ * @brief rescales every sample from the depth of "InDataT" to the depth of "OutDataT"
+ * @note BGR8 and BGR16 keep 4 samples per pixel (the padding counts as one) and go through the vector kernel, BGR32 (3 samples per pixel) goes pixel by pixel
+ */
+convert_pixels_bgr :: proc "contextless" (dst: []BGR($OutDataT), src: []BGR($InDataT)) {
+    O :: intrinsics.type_field_type(OutDataT, "data");
+    I :: intrinsics.type_field_type(InDataT, "data");
+    count := min(len(dst), len(src));
+    when size_of(BGR(OutDataT)) / size_of(O) == size_of(BGR(InDataT)) / size_of(I) {
+        kernel_rescale_samples(_samples(O, dst[:count]), _samples(I, src[:count]));
+    } else {
+        #no_bounds_check for i in 0..<count {
+            dst[i].b.data = rescale_sample(O, src[i].b.data);
+            dst[i].g.data = rescale_sample(O, src[i].g.data);
+            dst[i].r.data = rescale_sample(O, src[i].r.data);
+        }
+    }
+}
+
+convert_pixels_rgba :: proc "contextless" (dst: []RGBA($OutDataT), src: []RGBA($InDataT)) {
+    count := min(len(dst), len(src));
+    kernel_rescale_samples(_samples(intrinsics.type_field_type(OutDataT, "data"), dst[:count]), _samples(intrinsics.type_field_type(InDataT, "data"), src[:count]));
+}
+
+/**
+ * @brief BGR -> RGBA (alpha opaque), the 8 bit to 8 bit case is a single byte shuffle
+ */
+convert_pixels_bgr_to_rgba :: proc "contextless" (dst: []RGBA($OutDataT), src: []BGR($InDataT)) {
+    when OutDataT == PixelData8 && InDataT == PixelData8 {
+        kernel_bgr8_to_rgba8(dst, src);
+    } else {
+        O :: intrinsics.type_field_type(OutDataT, "data");
+        #no_bounds_check for i in 0..<min(len(dst), len(src)) {
+            dst[i].r.data = rescale_sample(O, src[i].r.data);
+            dst[i].g.data = rescale_sample(O, src[i].g.data);
+            dst[i].b.data = rescale_sample(O, src[i].b.data);
+            dst[i].a.data = max(O);
+        }
+    }
+}
+
+/**
+ * @brief RGBA -> BGR, alpha is dropped
+ */
+convert_pixels_rgba_to_bgr :: proc "contextless" (dst: []BGR($OutDataT), src: []RGBA($InDataT)) {
+    when OutDataT == PixelData8 && InDataT == PixelData8 {
+        kernel_rgba8_to_bgr8(dst, src);
+    } else {
+        O :: intrinsics.type_field_type(OutDataT, "data");
+        #no_bounds_check for i in 0..<min(len(dst), len(src)) {
+            dst[i].b.data = rescale_sample(O, src[i].b.data);
+            dst[i].g.data = rescale_sample(O, src[i].g.data);
+            dst[i].r.data = rescale_sample(O, src[i].r.data);
+        }
+    }
+}
+
+/**
+ * @note UnormBGR is packed to 13 bytes, so unlike the RGBA variant it cannot be treated as a flat array of samples
+ */
+convert_pixels_bgr_to_unorm :: proc "contextless" (dst: []UnormBGR, src: []BGR($InDataT)) {
+    I :: intrinsics.type_field_type(InDataT, "data");
+    SCALE :: f32(1) / f32(max(I));
+    #no_bounds_check for i in 0..<min(len(dst), len(src)) {
+        dst[i] = UNORM_BGR(Unorm(f32(src[i].b.data) * SCALE), Unorm(f32(src[i].g.data) * SCALE), Unorm(f32(src[i].r.data) * SCALE));
+    }
+}
+
+convert_pixels_rgba_to_unorm :: proc "contextless" (dst: []UnormRGBA, src: []RGBA($InDataT)) {
+    #assert(size_of(UnormRGBA) == 4 * size_of(f32));
+    count := min(len(dst), len(src));
+    kernel_unorm_samples(_samples(f32, dst[:count]), _samples(intrinsics.type_field_type(InDataT, "data"), src[:count]));
+}
+/*! PIXEL CONVERSIONS */
+
+/* IMAGE CONVERSIONS */
+/**
+ * @brief converts "src" into the already allocated "dst" (of the same size), row tiles are converted in parallel (@see parallel_tiles)
+ * @param pool already started pool reused across conversions, a pool is created for the call when nil
+ */
+convert_image_bgr :: proc(dst: ^Image2(BGR($OutDataT)), src: ^Image2(BGR($InDataT)), thread_count := 0, pool: ^thread.Pool = nil, location := #caller_location) {
+    assert(len(dst.data) == len(src.data), "Images of different sizes cannot be converted!", location);
+    Job :: struct { dst: []BGR(OutDataT), src: []BGR(InDataT) };
+    job := Job{ dst.data, src.data };
+    parallel_tiles(len(src.data), row_tile_pixels(int(src.size.x)), proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        convert_pixels_bgr(dst[begin:end], src[begin:end]);
+    }, &job, thread_count, pool);
+}
+
+convert_image_rgba :: proc(dst: ^Image2(RGBA($OutDataT)), src: ^Image2(RGBA($InDataT)), thread_count := 0, pool: ^thread.Pool = nil, location := #caller_location) {
+    assert(len(dst.data) == len(src.data), "Images of different sizes cannot be converted!", location);
+    Job :: struct { dst: []RGBA(OutDataT), src: []RGBA(InDataT) };
+    job := Job{ dst.data, src.data };
+    parallel_tiles(len(src.data), row_tile_pixels(int(src.size.x)), proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        convert_pixels_rgba(dst[begin:end], src[begin:end]);
+    }, &job, thread_count, pool);
+}
+
+convert_image_bgr_to_rgba :: proc(dst: ^Image2(RGBA($OutDataT)), src: ^Image2(BGR($InDataT)), thread_count := 0, pool: ^thread.Pool = nil, location := #caller_location) {
+    assert(len(dst.data) == len(src.data), "Images of different sizes cannot be converted!", location);
+    Job :: struct { dst: []RGBA(OutDataT), src: []BGR(InDataT) };
+    job := Job{ dst.data, src.data };
+    parallel_tiles(len(src.data), row_tile_pixels(int(src.size.x)), proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        convert_pixels_bgr_to_rgba(dst[begin:end], src[begin:end]);
+    }, &job, thread_count, pool);
+}
+
+convert_image_rgba_to_bgr :: proc(dst: ^Image2(BGR($OutDataT)), src: ^Image2(RGBA($InDataT)), thread_count := 0, pool: ^thread.Pool = nil, location := #caller_location) {
+    assert(len(dst.data) == len(src.data), "Images of different sizes cannot be converted!", location);
+    Job :: struct { dst: []BGR(OutDataT), src: []RGBA(InDataT) };
+    job := Job{ dst.data, src.data };
+    parallel_tiles(len(src.data), row_tile_pixels(int(src.size.x)), proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        convert_pixels_rgba_to_bgr(dst[begin:end], src[begin:end]);
+    }, &job, thread_count, pool);
+}
+
+convert_image :: proc { convert_image_bgr, convert_image_rgba, convert_image_bgr_to_rgba, convert_image_rgba_to_bgr }
+
+/**
+ * @brief BGR(X)8 pixels to packed RGB bytes ("dst" holds 3 bytes per pixel), in parallel tiles
+ */
+convert_bgr8_to_rgb8 :: proc(dst: []u8, src: []BGR8, thread_count := 0, pool: ^thread.Pool = nil, location := #caller_location) {
+    assert(len(dst) >= 3 * len(src), "Destination too small for the RGB bytes!", location);
+    Job :: struct { dst: []u8, src: []BGR8 };
+    job := Job{ dst, src };
+    parallel_tiles(len(src), CONVERT_TILE_PIXELS, proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        // "dst" sliced to the tile, so the overhang of the vector store never reaches into the tile of another thread
+        kernel_bgr8_to_rgb8(dst[3 * begin : 3 * end], src[begin:end]);
+    }, &job, thread_count, pool);
+}
+/*! IMAGE CONVERSIONS */
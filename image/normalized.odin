@@ -1,5 +1,7 @@
 package image;
 
+import "core:thread"
+
 Unorm :: distinct f32;
 
 UnormRGB :: struct #align (4) { // even though there is no alpha channel, we will pad the struct as if there were 4th byte
@@ -33,10 +35,19 @@ NormalizedBuffer :: struct($PixelType: typeid) #no_copy {
 UnormImageBGR  :: NormalizedBuffer(UnormBGR);
 UnormImageRGBA :: NormalizedBuffer(UnormRGBA);
 
-copy_transform :: proc($FROM: typeid, $TO: typeid, data: []FROM, transform_func: #type proc(val: FROM) -> TO) -> ^[]TO {
-    copy_buffer := make([]TO, len(data));
-    for i in 0..<len(data) do copy_buffer[i] = transform_func(data[i]);
-    return &copy_buffer;
+/**
+ * @brief applies "transform_func" to every element of "data" into a new buffer, in parallel tiles (@see parallel_tiles)
+ * @note "transform_func" is called from the pool threads, it must not touch shared state
+ * @param pool already started pool reused across calls, a pool is created for the call when nil
+ */
+copy_transform :: proc($FROM: typeid, $TO: typeid, data: []FROM, transform_func: #type proc(val: FROM) -> TO, thread_count := 0, pool: ^thread.Pool = nil) -> []TO {
+    Job :: struct { src: []FROM, dst: []TO, transform_func: #type proc(val: FROM) -> TO };
+    job := Job{ data, make([]TO, len(data)), transform_func };
+    parallel_tiles(len(data), CONVERT_TILE_PIXELS, proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        for i in begin..<end do dst[i] = transform_func(src[i]);
+    }, &job, thread_count, pool);
+    return job.dst;
 }
 
 @(private="file")
@@ -44,24 +55,32 @@ to_normalized1 :: proc(using img: ^Image) {
     assert(false, "TO DO!");
 }
 
+/**
+ * @brief every channel divided by the maximum of its depth (0..=1), in parallel row tiles
+ */
 @(private="file")
-to_normalized_bgr :: proc(using img: ^Image2(BGR($PixelData))) -> UnormImageBGR {
-    return {
-        size = size,
-        data = copy_transform(BGR, UnormBGR, data, proc(val: BGR) -> UnormBGR {
-            return UNORM_BGR(
-                cast(Unorm)(val.bgr.b) / 255, cast(Unorm)(val.bgr.g) / 255, cast(Unorm)(val.bgr.r) / 255,
-            );
-        })^,
-    };
+to_normalized_bgr :: proc(img: ^Image2(BGR($PixelDataT)), thread_count := 0, pool: ^thread.Pool = nil) -> UnormImageBGR {
+    Job :: struct { dst: []UnormBGR, src: []BGR(PixelDataT) };
+    job := Job{ make([]UnormBGR, len(img.data)), img.data };
+    parallel_tiles(len(img.data), row_tile_pixels(int(img.size.x)), proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        convert_pixels_bgr_to_unorm(dst[begin:end], src[begin:end]);
+    }, &job, thread_count, pool);
+    return { size = img.size, data = job.dst, };
 }
 
-// @(private="file")
-// to_normalized_rgba :: proc(using img: ^ImageRGBA) {
-//     assert(false, "TO DO!");
-// }
+@(private="file")
+to_normalized_rgba :: proc(img: ^Image2(RGBA($PixelDataT)), thread_count := 0, pool: ^thread.Pool = nil) -> UnormImageRGBA {
+    Job :: struct { dst: []UnormRGBA, src: []RGBA(PixelDataT) };
+    job := Job{ make([]UnormRGBA, len(img.data)), img.data };
+    parallel_tiles(len(img.data), row_tile_pixels(int(img.size.x)), proc(data: rawptr, begin, end: int) {
+        using job := cast(^Job)data;
+        convert_pixels_rgba_to_unorm(dst[begin:end], src[begin:end]);
+    }, &job, thread_count, pool);
+    return { size = img.size, data = job.dst, };
+}
 
-to_normalized :: proc { to_normalized1, to_normalized_bgr, /*to_normalized_rgba*/ }
+to_normalized :: proc { to_normalized1, to_normalized_bgr, to_normalized_rgba }
 
 @(private="file")
 dump_normalized1 :: proc(using img: ^NormalizedBuffer) {
@@ -74,8 +93,8 @@ dump_normalized_bgr :: #force_inline proc(using img: ^UnormImageBGR) {
 }
 
 @(private="file")
-dump_normalized_rgba :: proc(using img: ^UnormImageRGBA) {
-    assert(false, "TO DO!");
+dump_normalized_rgba :: #force_inline proc(using img: ^UnormImageRGBA) {
+    delete(data);
 }
 
 dump_normalized :: proc { dump_normalized1, dump_normalized_bgr, dump_normalized_rgba }
\ No newline at end of file
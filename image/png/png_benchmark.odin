@@ -0,0 +1,129 @@
+package main
+
+import "core:fmt"
+import "core:os"
+import "core:time"
+import "core:math/rand"
+import core_png "core:image/png"
+
+import image "../../image"
+import png   "../png"
+
+BENCHMARK_WIDTH  :: 3840;
+BENCHMARK_HEIGHT :: 2160;
+BENCHMARK_LEVELS :: [?]int { 0, 1, 6, 9 };
+
+/**
+ * @brief gradients with a bit of noise, closer to a photo than 'generate_random_image_ubgr' (which does not compress at all)
+ */
+generate_benchmark_image :: proc(img: ^image.ImageBGR8) {
+    img.data = make([]image.BGR8, img.size.x * img.size.y);
+    img.info = image.BGR_UUID | (image.UINT8_UUID << 4);
+    for y in 0..<int(img.size.y) {
+        for x in 0..<int(img.size.x) {
+            pixel := &img.data[y * int(img.size.x) + x];
+            noise := u8(rand.uint32() % 8);
+            pixel.r.data = u8(x * 255 / int(img.size.x)) + noise;
+            pixel.g.data = u8(y * 255 / int(img.size.y)) + noise;
+            pixel.b.data = u8((x + y) / 16) + noise;
+        }
+    }
+}
+
+main :: proc() {
+    img := image.ImageBGR8{ size = image.IMAGE_SIZE(BENCHMARK_WIDTH, BENCHMARK_HEIGHT), };
+    generate_benchmark_image(&img);
+    defer image.dump_image2(&img);
+
+    benchmark_write(&img);
+    benchmark_read(&img);
+}
+
+/**
+ * @brief throughput of 'init_IDAT' (filtering + deflate, without the file I/O) per level and thread count
+ * @note the core library has no png encoder to compare against, sizes are reported relative to the raw scanlines (which is what stored deflate, level 0, produces)
+ */
+benchmark_write :: proc(img: ^image.ImageBGR8) {
+    raw_size := (1 + 3 * BENCHMARK_WIDTH) * BENCHMARK_HEIGHT;
+    fmt.printf("Beginning [PNG WRITE BENCHMARK] %vx%v BGR8 (%.2f MB of scanlines)\n", BENCHMARK_WIDTH, BENCHMARK_HEIGHT, f64(raw_size) / (1024 * 1024));
+    fmt.printf("-----------------------------\n");
+    fmt.printf("\t%-6s %-8s %12s %12s %14s %8s\n", "level", "threads", "time [ms]", "MB/s", "size [bytes]", "ratio");
+
+    thread_counts := [?]int { 1, 2, 4, 8, os.processor_core_count() };
+    for level in BENCHMARK_LEVELS {
+        for thread_count in thread_counts {
+            start := time.tick_now();
+            chunks := png.init_IDAT(img.data, img.size, { level = level, thread_count = thread_count, });
+            duration := time.tick_since(start);
+
+            size := 0;
+            for chunk in chunks do size += len(chunk.compressed_data);
+            png.dump_IDAT(chunks);
+
+            fmt.printf(
+                "\t%-6v %-8v %12.3f %12.2f %14v %8.3f\n",
+                level, thread_count,
+                time.duration_milliseconds(duration),
+                f64(raw_size) / (1024 * 1024) / time.duration_seconds(duration),
+                size,
+                f64(size) / f64(raw_size),
+            );
+        }
+    }
+}
+
+Strip_Counter :: struct {
+    rows: int,
+}
+
+count_strip :: proc(user_data: rawptr, size: image.ImageSize, first_row: int, pixels: []image.BGR8) {
+    (cast(^Strip_Counter)user_data).rows += len(pixels) / int(size.x);
+}
+
+/**
+ * @brief decode throughput (MB/s of decoded scanlines) of 'png_read' and 'png_read_strips' against the core decoder, per compression level of the file
+ */
+benchmark_read :: proc(img: ^image.ImageBGR8) {
+    BENCHMARK_FILE :: "benchmark.png";
+    raw_size := (1 + 3 * BENCHMARK_WIDTH) * BENCHMARK_HEIGHT;
+    report :: proc(name: string, level: int, duration: time.Duration, raw_size: int) {
+        fmt.printf("\t%-24s %-6v %12.3f %12.2f\n", name, level, time.duration_milliseconds(duration), f64(raw_size) / (1024 * 1024) / time.duration_seconds(duration));
+    }
+
+    fmt.printf("\nBeginning [PNG READ BENCHMARK] %vx%v BGR8\n", BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+    fmt.printf("-----------------------------\n");
+    fmt.printf("\t%-24s %-6s %12s %12s\n", "decoder", "level", "time [ms]", "MB/s");
+    for level in BENCHMARK_LEVELS {
+        png.png_write(img, BENCHMARK_FILE, { level = level, });
+
+        {
+            start := time.tick_now();
+            decoded: image.ImageBGR8;
+            err := png.png_read(&decoded, BENCHMARK_FILE);
+            duration := time.tick_since(start);
+            assert(err == .E_NONE);
+            image.dump_image2(&decoded);
+            report("png_read", level, duration, raw_size);
+        }
+        {
+            handle, ok := os.open(BENCHMARK_FILE, os.O_RDONLY);
+            assert(ok == os.ERROR_NONE);
+            counter: Strip_Counter;
+            start := time.tick_now();
+            err := png.png_read_strips(os.stream_from_handle(handle), image.BGR8, count_strip, &counter);
+            duration := time.tick_since(start);
+            os.close(handle);
+            assert(err == .E_NONE && counter.rows == BENCHMARK_HEIGHT);
+            report("png_read_strips", level, duration, raw_size);
+        }
+        {
+            start := time.tick_now();
+            decoded, err := core_png.load(BENCHMARK_FILE);
+            duration := time.tick_since(start);
+            assert(err == nil);
+            core_png.destroy(decoded);
+            report("core:image/png", level, duration, raw_size);
+        }
+    }
+    os.remove(BENCHMARK_FILE);
+}
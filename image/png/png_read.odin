@@ -0,0 +1,487 @@
+package png
+
+import "base:runtime"
+import "core:io"
+import "core:os"
+
+import "../"
+import zlib "../zlib"
+
+PNG_READ_DEFAULT_STRIP_ROWS :: 64;
+
+TRNS_TYPE :: [4]u8 { 't', 'R', 'N', 'S' }; // transparency, only the palette variant is applied
+
+/**
+ * @brief streaming decoder: chunks are pulled from "reader" as the scanlines are asked for,
+ *        so besides the output only two scanlines, the inflate window and a few small buffers are kept in memory
+ * @note only non interlaced images are supported
+ */
+PNG_Decoder :: struct {
+    reader: io.Reader,
+    header: IHDR_Data,
+
+    palette:       [256]PNG_PaletteEntry,
+    palette_alpha: [256]u8, // tRNS, 255 for entries it does not cover
+    palette_size:  int,
+
+    // IDAT sequence, read through 'idat_stream'
+    chunk_remaining:   int,
+    chunk_crc:         u32,
+    idat_done:         bool,
+    next_chunk_length: u32,       // header of the first chunk after the IDAT sequence
+    next_chunk_type:   ChunkType,
+    err:               PNG_Error, // reason the IDAT stream stopped early
+
+    inflater: ^zlib.Inflater,
+
+    bpp:       int, // bytes per complete pixel (at least 1), distance used by the filters
+    stride:    int, // bytes of a scanline without its filter type byte
+    row:       []u8, // filter type byte + scanline
+    prev_row:  []u8,
+    row_index: int,
+}
+
+/* CHUNKS */
+@(private="file")
+_read_chunk_header :: proc(reader: io.Reader) -> (length: u32, type: ChunkType, err: PNG_Error) {
+    bytes: [8]u8;
+    if _, e := io.read_full(reader, bytes[:]); e != nil do return 0, {}, .E_READ_CRITICAL;
+    length = u32(bytes[0]) << 24 | u32(bytes[1]) << 16 | u32(bytes[2]) << 8 | u32(bytes[3]);
+    if length > CHUNK_MAX_LENGTH do return 0, {}, .E_READ_CHUNK_SIZE;
+    copy(type[:], bytes[4:]);
+    return length, type, .E_NONE;
+}
+
+@(private="file")
+_read_chunk_crc :: proc(reader: io.Reader, crc: u32) -> PNG_Error {
+    bytes: [4]u8;
+    if _, e := io.read_full(reader, bytes[:]); e != nil do return .E_READ_CRITICAL;
+    expected := u32(bytes[0]) << 24 | u32(bytes[1]) << 16 | u32(bytes[2]) << 8 | u32(bytes[3]);
+    return expected == crc ? .E_NONE : .E_READ_CRC;
+}
+
+/**
+ * @brief reads the data and the crc of a chunk whose header has already been read, the crc is checked
+ */
+png_read_chunk :: proc(reader: io.Reader, length: u32, type: ChunkType, buffer: ^[dynamic]u8) -> PNG_Error {
+    resize(buffer, int(length));
+    if _, e := io.read_full(reader, buffer[:]); e != nil do return .E_READ_CRITICAL;
+    return _read_chunk_crc(reader, crc32(type, buffer[:]));
+}
+
+@(private="file")
+_is_critical :: #force_inline proc "contextless" (type: ChunkType) -> bool {
+    return type[0] >= 'A' && type[0] <= 'Z';
+}
+
+/**
+ * @brief the IDAT chunks as a single stream of zlib data, crc of every chunk is checked once it has been read whole
+ */
+@(private="file")
+_idat_stream_proc :: proc(stream_data: rawptr, mode: io.Stream_Mode, p: []byte, offset: i64, whence: io.Seek_From) -> (n: i64, err: io.Error) {
+    decoder := cast(^PNG_Decoder)stream_data;
+    #partial switch mode {
+        case .Read:
+            for decoder.chunk_remaining == 0 {
+                if decoder.idat_done do return 0, .EOF;
+                if e := _read_chunk_crc(decoder.reader, decoder.chunk_crc); e != .E_NONE {
+                    decoder.err = e;
+                    return 0, .Unknown;
+                }
+                length, type, e := _read_chunk_header(decoder.reader);
+                if e != .E_NONE {
+                    decoder.err = e;
+                    return 0, .Unknown;
+                }
+                if type != IDAT_TYPE {
+                    decoder.idat_done = true;
+                    decoder.next_chunk_length, decoder.next_chunk_type = length, type;
+                    return 0, .EOF;
+                }
+                decoder.chunk_remaining = int(length);
+                decoder.chunk_crc = crc32(type, {});
+            }
+            read, e := io.read(decoder.reader, p[:min(len(p), decoder.chunk_remaining)]);
+            if read <= 0 {
+                decoder.err = .E_READ_DATA;
+                return 0, e != nil ? e : .Unexpected_EOF;
+            }
+            decoder.chunk_crc = crc32_update(decoder.chunk_crc, p[:read]);
+            decoder.chunk_remaining -= read;
+            return i64(read), nil;
+        case .Query:
+            return io.query_utility({ .Read, .Query });
+    }
+    return 0, .Empty;
+}
+/*! CHUNKS */
+
+/* DECODER */
+/**
+ * @brief reads the signature and every chunk up to the first IDAT
+ */
+png_decoder_init :: proc(using decoder: ^PNG_Decoder, source: io.Reader) -> (err: PNG_Error) {
+    decoder^ = {};
+    reader = source;
+
+    signature: [8]u8;
+    if _, e := io.read_full(reader, signature[:]); e != nil do return .E_READ_SIGNATURE;
+    for v, i in PNG_HEADER do if signature[i] != v do return .E_READ_SIGNATURE;
+
+    buffer := make([dynamic]u8);
+    defer delete(buffer);
+    has_header := false;
+    for {
+        length, type := _read_chunk_header(reader) or_return;
+        if !has_header && type != IHDR_TYPE do return .E_READ_MISSING_IHDR;
+
+        if type == IDAT_TYPE {
+            chunk_remaining = int(length);
+            chunk_crc = crc32(type, {});
+            break;
+        }
+        png_read_chunk(reader, length, type, &buffer) or_return;
+
+        if type == IHDR_TYPE {
+            if length != IHDR_DataLength do return .E_READ_CHUNK_SIZE;
+            header = {
+                width         = u32(buffer[0]) << 24 | u32(buffer[1]) << 16 | u32(buffer[2]) << 8 | u32(buffer[3]),
+                height        = u32(buffer[4]) << 24 | u32(buffer[5]) << 16 | u32(buffer[6]) << 8 | u32(buffer[7]),
+                bit_depth     = buffer[8],
+                color_type    = buffer[9],
+                m_compression = buffer[10],
+                m_filter      = buffer[11],
+                m_interlace   = buffer[12],
+            };
+            has_header = true;
+        } else if type == PLTE_TYPE {
+            if length % 3 != 0 || length > 3 * 256 do return .E_READ_NUM_PALETTE_ENTRIES;
+            palette_size = int(length / 3);
+            for i in 0..<palette_size do palette[i] = { buffer[3 * i], buffer[3 * i + 1], buffer[3 * i + 2] };
+            for &a in palette_alpha do a = 255;
+        } else if type == TRNS_TYPE && header.color_type == COLOR_TYPE_PALETTE {
+            copy(palette_alpha[:], buffer[:]);
+        } else if type == IEND_TYPE {
+            return .E_READ_CRITICAL; // no image data
+        } else if _is_critical(type) {
+            return .E_READ_CRITICAL; // unknown critical chunk, the image cannot be displayed correctly without it
+        }
+    }
+
+    if header.width == 0 || header.height == 0 do return .E_READ_SIZE;
+    if header.width > _4BYTE_MAX_VALUE || header.height > _4BYTE_MAX_VALUE do return .E_READ_SIZE; // the limit of the png specification
+    if header.m_compression != 0 || header.m_filter != 0 do return .E_READ_COMPRESSION_CODE_UNRECOGNIZED;
+    if Interlace(header.m_interlace) != NO_INTERLACE do return .E_READ_INTERLACE_UNSUPPORTED;
+
+    channels: int;
+    switch header.color_type {
+        case COLOR_TYPE_GRAY:       channels = 1;
+        case COLOR_TYPE_RGB:        channels = 3;
+        case COLOR_TYPE_PALETTE:    channels = 1;
+        case COLOR_TYPE_GRAY_ALPHA: channels = 2;
+        case COLOR_TYPE_RGBA:       channels = 4;
+        case: return .E_READ_COLOR_TYPE_SUM_INVALID;
+    }
+    switch header.bit_depth {
+        case 1, 2, 4:
+            if header.color_type != COLOR_TYPE_GRAY && header.color_type != COLOR_TYPE_PALETTE do return .E_READ_COLOR_TYPE_SUM_INVALID;
+        case 8:
+        case 16:
+            if header.color_type == COLOR_TYPE_PALETTE do return .E_READ_COLOR_TYPE_SUM_INVALID;
+        case:
+            return .E_READ_COLOR_TYPE_SUM_INVALID;
+    }
+    if header.color_type == COLOR_TYPE_PALETTE && palette_size == 0 do return .E_READ_MISSING_PLTE;
+
+    bits_per_pixel := channels * int(header.bit_depth);
+    bpp    = max(1, bits_per_pixel / 8);
+    stride = (int(header.width) * bits_per_pixel + 7) / 8; // at most 2^31 * 64 bits, no overflow
+    alloc_err: runtime.Allocator_Error;
+    row, alloc_err = make([]u8, stride + 1);
+    if alloc_err != .None do return .E_READ_ALLOCATION;
+    prev_row, alloc_err = make([]u8, stride + 1);
+    if alloc_err != .None {
+        delete(row);
+        row = nil;
+        return .E_READ_ALLOCATION;
+    }
+
+    inflater = new(zlib.Inflater);
+    zlib.inflater_init(inflater, idat_stream(decoder));
+    return .E_NONE;
+}
+
+dump_png_decoder :: proc(using decoder: ^PNG_Decoder) {
+    delete(row);
+    delete(prev_row);
+    free(inflater);
+    decoder^ = {};
+}
+
+idat_stream :: #force_inline proc(decoder: ^PNG_Decoder) -> io.Reader {
+    return { procedure = _idat_stream_proc, data = decoder, };
+}
+
+png_decoder_size :: #force_inline proc "contextless" (decoder: ^PNG_Decoder) -> image.ImageSize {
+    return { decoder.header.width, decoder.header.height };
+}
+
+/**
+ * @brief reverts the filter of "row" (filter type byte excluded) in place
+ * @param prev previous, already unfiltered scanline (zeroes for the first one)
+ */
+unfilter_scanline :: proc "contextless" (filter: MFilterType, row: []u8, prev: []u8, bpp: int) {
+    switch filter {
+        case .None:
+        case .Sub:
+            for i in bpp..<len(row) do row[i] += row[i - bpp];
+        case .Up:
+            for i in 0..<len(row) do row[i] += prev[i];
+        case .Average:
+            for i in 0..<min(bpp, len(row)) do row[i] += prev[i] >> 1;
+            for i in bpp..<len(row) do row[i] += u8((u16(row[i - bpp]) + u16(prev[i])) >> 1);
+        case .Paeth:
+            for i in 0..<min(bpp, len(row)) do row[i] += prev[i];
+            for i in bpp..<len(row) do row[i] += _paeth(row[i - bpp], prev[i], prev[i - bpp]);
+    }
+}
+
+/**
+ * @brief inflates and unfilters the next scanline
+ * @return raw scanline (samples as stored in the file), valid until the next call
+ */
+png_decoder_next_row :: proc(using decoder: ^PNG_Decoder) -> (scanline: []u8, err: PNG_Error) {
+    if row_index >= int(header.height) do return nil, .E_READ_DATA;
+    row, prev_row = prev_row, row;
+
+    n, inflate_err := zlib.inflate_read(inflater, row);
+    if inflate_err != .None || n < len(row) do return nil, decoder.err != .E_NONE ? decoder.err : .E_READ_DATA;
+    if row[0] > u8(max(MFilterType)) do return nil, .E_READ_FILTER_TYPE;
+
+    unfilter_scanline(MFilterType(row[0]), row[1:], prev_row[1:], bpp);
+    row_index += 1;
+    return row[1:], .E_NONE;
+}
+
+/**
+ * @brief verifies the end of the zlib stream and reads the chunks after the image data up to IEND
+ */
+png_decoder_finish :: proc(using decoder: ^PNG_Decoder) -> PNG_Error {
+    if zlib.inflate_finish(inflater) != .None do return decoder.err != .E_NONE ? decoder.err : .E_READ_DATA;
+    // IDAT chunks might continue past the end of the zlib stream (empty ones usually), they still have to be checked
+    scratch: [256]u8;
+    for !idat_done {
+        if _, e := io.read(idat_stream(decoder), scratch[:]); e != nil && !idat_done do return decoder.err != .E_NONE ? decoder.err : .E_READ_DATA;
+    }
+
+    buffer := make([dynamic]u8);
+    defer delete(buffer);
+    length, type := next_chunk_length, next_chunk_type;
+    for {
+        png_read_chunk(reader, length, type, &buffer) or_return;
+        if type == IEND_TYPE do return .E_NONE;
+        if _is_critical(type) && type != PLTE_TYPE do return .E_READ_CRITICAL;
+
+        e: PNG_Error;
+        length, type, e = _read_chunk_header(reader);
+        if e != .E_NONE do return .E_READ_MISSING_IEND;
+    }
+}
+/*! DECODER */
+
+/* PIXEL CONVERSION */
+/**
+ * @brief "index"-th sample of "scanline" (1, 2, 4 bit samples are packed MSB first, 16 bit ones are big endian)
+ */
+@(private="file")
+_sample :: #force_inline proc "contextless" (scanline: []u8, index: int, depth: u8) -> u32 {
+    switch depth {
+        case 8:  return u32(scanline[index]);
+        case 16: return u32(scanline[2 * index]) << 8 | u32(scanline[2 * index + 1]);
+    }
+    bit := index * int(depth);
+    shift := 8 - uint(depth) - uint(bit & 7);
+    return (u32(scanline[bit >> 3]) >> shift) & ((1 << depth) - 1);
+}
+
+/**
+ * @brief rescales a sample of "depth" bits to the full range of T (bit replication, exact for every png depth)
+ */
+@(private="file")
+_scale_sample :: #force_inline proc "contextless" (value: u32, depth: u8, $T: typeid) -> T {
+    value, depth := value, depth;
+    if depth < 8 {
+        value *= 255 / ((1 << depth) - 1);
+        depth = 8;
+    }
+    when size_of(T) == 1 {
+        return T(depth == 16 ? value >> 8 : value);
+    } else when size_of(T) == 2 {
+        return T(depth == 16 ? value : value * 257);
+    } else {
+        return T(depth == 16 ? value * 65537 : value * 0x01010101);
+    }
+}
+
+/**
+ * @return channels of the "x"-th pixel, depth of the samples (palette entries are always 8 bit)
+ */
+@(private="file")
+_pixel_samples :: #force_inline proc "contextless" (decoder: ^PNG_Decoder, scanline: []u8, x: int) -> (rgba: [4]u32, depth: u8) {
+    depth = decoder.header.bit_depth;
+    alpha := u32(1 << depth) - 1;
+    switch decoder.header.color_type {
+        case COLOR_TYPE_GRAY:
+            v := _sample(scanline, x, depth);
+            rgba = { v, v, v, alpha };
+        case COLOR_TYPE_RGB:
+            rgba = { _sample(scanline, 3 * x, depth), _sample(scanline, 3 * x + 1, depth), _sample(scanline, 3 * x + 2, depth), alpha };
+        case COLOR_TYPE_PALETTE:
+            index := _sample(scanline, x, depth);
+            entry := decoder.palette[index];
+            rgba = { u32(entry[0]), u32(entry[1]), u32(entry[2]), u32(decoder.palette_alpha[index]) };
+            depth = 8;
+        case COLOR_TYPE_GRAY_ALPHA:
+            v := _sample(scanline, 2 * x, depth);
+            rgba = { v, v, v, _sample(scanline, 2 * x + 1, depth) };
+        case COLOR_TYPE_RGBA:
+            rgba = { _sample(scanline, 4 * x, depth), _sample(scanline, 4 * x + 1, depth), _sample(scanline, 4 * x + 2, depth), _sample(scanline, 4 * x + 3, depth) };
+    }
+    return;
+}
+
+png_convert_row_bgr :: proc(decoder: ^PNG_Decoder, scanline: []u8, pixels: []image.BGR($PixelDataT)) {
+    when size_of(PixelDataT) == 1 {
+        // the common case, no per pixel dispatch
+        if decoder.header.bit_depth == 8 && decoder.header.color_type == COLOR_TYPE_RGB {
+            for &pixel, x in pixels {
+                pixel.r.data = scanline[3 * x];
+                pixel.g.data = scanline[3 * x + 1];
+                pixel.b.data = scanline[3 * x + 2];
+            }
+            return;
+        }
+    }
+    for &pixel, x in pixels {
+        rgba, depth := _pixel_samples(decoder, scanline, x);
+        pixel.r.data = _scale_sample(rgba[0], depth, type_of(pixel.r.data));
+        pixel.g.data = _scale_sample(rgba[1], depth, type_of(pixel.g.data));
+        pixel.b.data = _scale_sample(rgba[2], depth, type_of(pixel.b.data));
+    }
+}
+
+png_convert_row_rgba :: proc(decoder: ^PNG_Decoder, scanline: []u8, pixels: []image.RGBA($PixelDataT)) {
+    when size_of(PixelDataT) == 1 {
+        if decoder.header.bit_depth == 8 && decoder.header.color_type == COLOR_TYPE_RGBA {
+            copy((cast([^]u8)raw_data(pixels))[:4 * len(pixels)], scanline);
+            return;
+        }
+    }
+    for &pixel, x in pixels {
+        rgba, depth := _pixel_samples(decoder, scanline, x);
+        pixel.r.data = _scale_sample(rgba[0], depth, type_of(pixel.r.data));
+        pixel.g.data = _scale_sample(rgba[1], depth, type_of(pixel.g.data));
+        pixel.b.data = _scale_sample(rgba[2], depth, type_of(pixel.b.data));
+        pixel.a.data = _scale_sample(rgba[3], depth, type_of(pixel.a.data));
+    }
+}
+
+png_convert_row :: proc { png_convert_row_bgr, png_convert_row_rgba }
+/*! PIXEL CONVERSION */
+
+/* READ */
+png_read :: proc { png_read_bgr, png_read_rgba }
+
+png_read_bgr :: proc(img: ^image.Image2(image.BGR($PixelDataT)), file_path: string) -> PNG_Error {
+    return _png_read_file(img, file_path, image.BGR_UUID | (_pixel_uuid(PixelDataT) << 4));
+}
+
+png_read_rgba :: proc(img: ^image.Image2(image.RGBA($PixelDataT)), file_path: string) -> PNG_Error {
+    return _png_read_file(img, file_path, image.RGBA_UUID | (_pixel_uuid(PixelDataT) << 4));
+}
+
+@(private="file")
+_pixel_uuid :: #force_inline proc "contextless" ($PixelDataT: typeid) -> image.PixelTypeUUID {
+    when size_of(PixelDataT) == 1 do return image.UINT8_UUID;
+    else when size_of(PixelDataT) == 2 do return image.UINT16_UUID;
+    else do return image.UINT32_UUID;
+}
+
+@(private="file")
+_png_read_file :: proc(img: ^image.Image2($Pixel), file_path: string, info: image.ImageInfoUUID) -> PNG_Error {
+    handle, ok := os.open(file_path, os.O_RDONLY);
+    if ok != os.ERROR_NONE do return .E_READ_OPEN;
+    defer os.close(handle);
+    return png_read_from_reader(img, os.stream_from_handle(handle), info);
+}
+
+/**
+ * @brief "width" * "rows" pixels of "Pixel" can be addressed (both are at most 2^31 - 1, their product times the pixel size may still overflow)
+ */
+@(private="file")
+_pixels_fit :: #force_inline proc "contextless" ($Pixel: typeid, width, rows: int) -> PNG_Error {
+    if width > max(int) / size_of(Pixel) / rows do return .E_READ_SIZE;
+    return .E_NONE;
+}
+
+/**
+ * @brief decodes the whole image into "img" (allocated here, @see image.dump_image2), the compressed data is never held in memory as a whole
+ * @param info image/pixel type UUIDs stored into "img", 'png_read' fills them in from the pixel type
+ */
+png_read_from_reader :: proc(img: ^image.Image2($Pixel), reader: io.Reader, info: image.ImageInfoUUID) -> (err: PNG_Error) {
+    decoder: PNG_Decoder;
+    png_decoder_init(&decoder, reader) or_return;
+    defer dump_png_decoder(&decoder);
+
+    width, height := int(decoder.header.width), int(decoder.header.height);
+    _pixels_fit(Pixel, width, height) or_return;
+    alloc_err: runtime.Allocator_Error;
+    img.data, alloc_err = make([]Pixel, width * height);
+    if alloc_err != .None do return .E_READ_ALLOCATION;
+    img.size = png_decoder_size(&decoder);
+    img.info = info;
+    defer if err != .E_NONE {
+        delete(img.data);
+        img.data = nil;
+    }
+
+    for y in 0..<height {
+        scanline := png_decoder_next_row(&decoder) or_return;
+        png_convert_row(&decoder, scanline, img.data[y * width : (y + 1) * width]);
+    }
+    return png_decoder_finish(&decoder);
+}
+
+/**
+ * @brief row-callback mode: the image is decoded in strips of "strip_rows" rows, each handed to "callback" and then overwritten by the next one
+ * @note memory needed is one strip plus the decoder's (@see PNG_Decoder), independent of the image height
+ */
+png_read_strips :: proc(
+    reader: io.Reader,
+    $Pixel: typeid,
+    callback: proc(user_data: rawptr, size: image.ImageSize, first_row: int, pixels: []Pixel),
+    user_data: rawptr = nil,
+    strip_rows := PNG_READ_DEFAULT_STRIP_ROWS,
+) -> PNG_Error {
+    decoder: PNG_Decoder;
+    png_decoder_init(&decoder, reader) or_return;
+    defer dump_png_decoder(&decoder);
+
+    width, height := int(decoder.header.width), int(decoder.header.height);
+    strip_rows := clamp(strip_rows, 1, height);
+    _pixels_fit(Pixel, width, strip_rows) or_return;
+    strip, alloc_err := make([]Pixel, width * strip_rows);
+    if alloc_err != .None do return .E_READ_ALLOCATION;
+    defer delete(strip);
+
+    for first_row := 0; first_row < height; first_row += strip_rows {
+        rows := min(strip_rows, height - first_row);
+        for y in 0..<rows {
+            scanline := png_decoder_next_row(&decoder) or_return;
+            png_convert_row(&decoder, scanline, strip[y * width : (y + 1) * width]);
+        }
+        callback(user_data, png_decoder_size(&decoder), first_row, strip[:rows * width]);
+    }
+    return png_decoder_finish(&decoder);
+}
+/*! READ */
@@ -0,0 +1,115 @@
+package main
+
+import "core:fmt"
+import "core:log"
+import "core:os"
+
+import image "../../image"
+import png   "../png"
+
+/**
+ * @brief pixels of "decoded" have to match "img" exactly (both are BGR of the same depth, except BGR32 which png stores as 16 bit)
+ */
+compare_bgr :: proc(name: string, img: ^image.Image2(image.BGR($PixelDataT)), decoded: []image.BGR(PixelDataT), first_row := 0) {
+    SHIFT :: size_of(PixelDataT) == 4 ? 16 : 0;
+    offset := first_row * int(img.size.x);
+    for pixel, i in decoded {
+        expected := img.data[offset + i];
+        fmt.assertf(
+            pixel.r.data >> SHIFT == expected.r.data >> SHIFT && pixel.g.data >> SHIFT == expected.g.data >> SHIFT && pixel.b.data >> SHIFT == expected.b.data >> SHIFT,
+            "\x1b[31m[%v] pixels do not match at [%v]: %v :: %v\x1b[0m\n", name, offset + i, pixel, expected,
+        );
+    }
+}
+
+round_trip :: proc(img: ^image.Image2(image.BGR($PixelDataT)), file_path: string, options: png.PNG_Write_Options) {
+    png.png_write(img, file_path, options);
+
+    decoded: image.Image2(image.BGR(PixelDataT));
+    err := png.png_read(&decoded, file_path);
+    fmt.assertf(err == .E_NONE, "\x1b[31m[%v] png_read failed: %v\x1b[0m\n", file_path, err);
+    defer image.dump_image2(&decoded);
+    fmt.assertf(decoded.size == img.size, "\x1b[31m[%v] size mismatch: %v :: %v\x1b[0m\n", file_path, decoded.size, img.size);
+    fmt.assertf(decoded.info == img.info, "\x1b[31m[%v] info mismatch: %v :: %v\x1b[0m\n", file_path, decoded.info, img.info);
+    compare_bgr(file_path, img, decoded.data);
+    log.infof("[%v] level %v: round trip OK", file_path, options.level);
+}
+
+Strip_Check :: struct {
+    img:  ^image.ImageBGR8,
+    rows: int,
+}
+
+strip_callback :: proc(user_data: rawptr, size: image.ImageSize, first_row: int, pixels: []image.BGR8) {
+    check := cast(^Strip_Check)user_data;
+    fmt.assertf(first_row == check.rows, "\x1b[31mstrips out of order: %v :: %v\x1b[0m\n", first_row, check.rows);
+    compare_bgr("strips", check.img, pixels, first_row);
+    check.rows += len(pixels) / int(size.x);
+}
+
+main :: proc() {
+    context.logger = log.create_console_logger(.Warning);
+
+    img8 := image.ImageBGR8{ size = image.IMAGE_SIZE(333, 217), };
+    image.generate_random_image_ubgr(&img8);
+    defer image.dump_image2(&img8);
+    // half of the image compressible, so that every filter and every block type gets used
+    for &pixel, i in img8.data[:len(img8.data) / 2] do pixel.r.data, pixel.g.data, pixel.b.data = u8(i % 333), u8(i / 333), 0x7f;
+
+    for level in 0..=9 do round_trip(&img8, "read_bgr8.png", { level = level, thread_count = 3, });
+
+    img16 := image.ImageBGR16{ size = image.IMAGE_SIZE(129, 65), };
+    image.generate_random_image_ubgr(&img16);
+    defer image.dump_image2(&img16);
+    round_trip(&img16, "read_bgr16.png", png.DEFAULT_PNG_WRITE_OPTIONS);
+
+    img32 := image.ImageBGR32{ size = image.IMAGE_SIZE(65, 129), };
+    image.generate_random_image_ubgr(&img32);
+    defer image.dump_image2(&img32);
+    round_trip(&img32, "read_bgr32.png", png.DEFAULT_PNG_WRITE_OPTIONS);
+
+    // row-callback mode
+    {
+        png.png_write(&img8, "read_bgr8.png");
+        handle, ok := os.open("read_bgr8.png", os.O_RDONLY);
+        assert(ok == os.ERROR_NONE);
+        defer os.close(handle);
+
+        check := Strip_Check{ img = &img8, };
+        err := png.png_read_strips(os.stream_from_handle(handle), image.BGR8, strip_callback, &check, 16);
+        fmt.assertf(err == .E_NONE, "\x1b[31mpng_read_strips failed: %v\x1b[0m\n", err);
+        fmt.assertf(check.rows == int(img8.size.y), "\x1b[31mstrips covered %v rows out of %v\x1b[0m\n", check.rows, img8.size.y);
+    }
+
+    // RGBA output of an RGB file: alpha is opaque
+    {
+        decoded: image.ImageRGBA16;
+        err := png.png_read(&decoded, "read_bgr8.png");
+        fmt.assertf(err == .E_NONE, "\x1b[31mpng_read (RGBA16) failed: %v\x1b[0m\n", err);
+        defer image.dump_image2(&decoded);
+        for pixel, i in decoded.data {
+            expected := img8.data[i];
+            fmt.assertf(
+                pixel.r.data == u16(expected.r.data) * 257 && pixel.g.data == u16(expected.g.data) * 257 && pixel.b.data == u16(expected.b.data) * 257 && pixel.a.data == 0xffff,
+                "\x1b[31m[RGBA16] pixels do not match at [%v]: %v :: %v\x1b[0m\n", i, pixel, expected,
+            );
+        }
+    }
+
+    // corrupted data has to be caught by the crc
+    {
+        bytes, ok := os.read_entire_file_from_filename("read_bgr8.png");
+        assert(ok);
+        bytes[len(bytes) / 2] ~= 0x5a;
+        os.write_entire_file("read_corrupted.png", bytes);
+        delete(bytes);
+
+        decoded: image.ImageBGR8;
+        err := png.png_read(&decoded, "read_corrupted.png");
+        fmt.assertf(err != .E_NONE, "\x1b[31mcorrupted file decoded without an error\x1b[0m\n");
+        fmt.assertf(decoded.data == nil, "\x1b[31mimage data of a failed read has to be released\x1b[0m\n");
+    }
+
+    for file in ([]string{ "read_bgr8.png", "read_bgr16.png", "read_bgr32.png", "read_corrupted.png" }) do os.remove(file);
+    fmt.printf("\x1b[32mpng read round trip passed!\x1b[0m\n");
+}
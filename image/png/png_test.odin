@@ -1,6 +1,8 @@
 package main
 
+import "core:fmt"
 import "core:log"
+import core_png "core:image/png"
 
 import image       "../../image"
 import performance "../../performance_profiler"
@@ -24,6 +26,11 @@ main :: proc() {
         assert(generated_image.info & image.IMAGE_INFO_PIXEL_TYPE_UUID_MASK == (image.UINT8_UUID << 4), "UUID (PIXEL_TYPE) IS INCORRECT");
 
         png.png_write_bgr8(&generated_image, "bgr8.png");
+        check_png(&generated_image, "bgr8.png");
+        for level in 0..=9 {
+            png.png_write_bgr8(&generated_image, "bgr8.png", { level = level, thread_count = 4, });
+            check_png(&generated_image, "bgr8.png");
+        }
     }
     stamp := performance.end(&profiler);
 
@@ -40,8 +47,8 @@ main :: proc() {
         assert(generated_image.info & image.IMAGE_INFO_IMAGE_TYPE_UUID_MASK == image.BGR_UUID, "UUID (IMAGE_TYPE) IS INCORRECT");
         assert(generated_image.info & image.IMAGE_INFO_PIXEL_TYPE_UUID_MASK == (image.UINT16_UUID << 4), "UUID (PIXEL_TYPE) IS INCORRECT");
 
-        png.png_write_bgr16(&generated_image, "bgr16.png");
-        assert(false, "do the 'file extension checking'");
+        png.png_write_bgr16(&generated_image, "bgr16");
+        check_png(&generated_image, "bgr16.png");
     }
     stamp = performance.end(&profiler);
 
@@ -58,10 +65,40 @@ main :: proc() {
         assert(generated_image.info & image.IMAGE_INFO_IMAGE_TYPE_UUID_MASK == image.BGR_UUID, "UUID (IMAGE_TYPE) IS INCORRECT");
         assert(generated_image.info & image.IMAGE_INFO_PIXEL_TYPE_UUID_MASK == (image.UINT32_UUID << 4), "UUID (PIXEL_TYPE) IS INCORRECT");
 
-        png.png_write_bgr32(&generated_image, "bgr32.png");
-        assert(false, "do the 'file extension checking'");
+        png.png_write_bgr32(&generated_image, "bgr32");
+        check_png(&generated_image, "bgr32.png");
     }
     stamp = performance.end(&profiler);
 
     log.infof("Time taken: %v ms", performance.delta_milliseconds(stamp));
-}
\ No newline at end of file
+}
+
+/**
+ * @brief decodes "file_path" with the core png decoder and compares it to the image it has been written from
+ */
+check_png :: proc(img: ^image.Image2(image.BGR($PixelDataT)), file_path: string) {
+    decoded, err := core_png.load(file_path);
+    fmt.assertf(err == nil, "\x1b[31mFailed to decode %v: %v\x1b[0m\n", file_path, err);
+    defer core_png.destroy(decoded);
+
+    fmt.assertf(
+        decoded.width == int(img.size.x) && decoded.height == int(img.size.y) && decoded.channels == 3,
+        "\x1b[31m%v: size mismatch %vx%vx%v\x1b[0m\n", file_path, decoded.width, decoded.height, decoded.channels,
+    );
+
+    pixels := decoded.pixels.buf[:];
+    for pixel, i in img.data {
+        when size_of(PixelDataT) == 1 {
+            fmt.assertf(decoded.depth == 8, "\x1b[31m%v: bit depth %v\x1b[0m\n", file_path, decoded.depth);
+            r, g, b := u32(pixels[i * 3]), u32(pixels[i * 3 + 1]), u32(pixels[i * 3 + 2]);
+            er, eg, eb := u32(pixel.r.data), u32(pixel.g.data), u32(pixel.b.data);
+        } else {
+            fmt.assertf(decoded.depth == 16, "\x1b[31m%v: bit depth %v\x1b[0m\n", file_path, decoded.depth);
+            samples := (cast([^]u16)raw_data(pixels))[:len(pixels) / 2]; // the core decoder stores 16 bit samples in native order
+            r, g, b := u32(samples[i * 3]), u32(samples[i * 3 + 1]), u32(samples[i * 3 + 2]);
+            SHIFT :: (size_of(PixelDataT) - 2) * 8; // 32 bit samples are narrowed down to 16 bits
+            er, eg, eb := u32(pixel.r.data) >> SHIFT, u32(pixel.g.data) >> SHIFT, u32(pixel.b.data) >> SHIFT;
+        }
+        fmt.assertf(r == er && g == eg && b == eb, "\x1b[31m%v: pixels do not match at [%v]: %v :: %v\x1b[0m\n", file_path, i, [3]u32{ r, g, b }, [3]u32{ er, eg, eb });
+    }
+}
@@ -1,10 +1,15 @@
 package image
 
+import "base:intrinsics"
+import "core:thread"
+
 /* CONVERSION FUNCTIONS */
+/**
+ * @note widening replicates the bits and narrowing keeps the upper ones (@see rescale_sample), which maps 0 -> 0 and max -> max exactly
+ */
 reinterpret_pixel_data :: #force_inline proc($OutDataT: typeid, value: $InDataT) -> OutDataT {
-    /* FORMULA: (original_value) * (max_pixel_new_value) / (max_pixel_former_value) */
     return cast(OutDataT) {
-        data = auto_cast ((value.data * ((1 << size_of(OutDataT)) - 1)) / ((1 << size_of(InDataT)) - 1)),
+        data = rescale_sample(intrinsics.type_field_type(OutDataT, "data"), value.data),
     };
 }
 
@@ -62,34 +67,38 @@ query_sUUID :: proc(OutDataT: typeid) -> ImageInfoUUID {
     return ImageInfoInvalid; 
 }
 
-reinterpret_image_bgr_discard :: proc($ImageAfterT: typeid/Image2(BGR($OutDataT)), $ImageBeforeT: typeid/Image2(BGR($InDataT)), using img: ^ImageBeforeT) -> ImageAfterT {
+reinterpret_image_bgr_discard :: proc($ImageAfterT: typeid/Image2(BGR($OutDataT)), $ImageBeforeT: typeid/Image2(BGR($InDataT)), using img: ^ImageBeforeT, thread_count := 0, pool: ^thread.Pool = nil) -> ImageAfterT {
     defer delete(data);
-    return reinterpret_image_bgr(ImageAfterT, ImageBeforeT, img);
+    return reinterpret_image_bgr(ImageAfterT, ImageBeforeT, img, thread_count, pool);
 }
 
-reinterpret_image_rgba_discard :: proc($ImageAfterT: typeid/Image2(RGBA($OutDataT)), $ImageBeforeT: typeid/Image2(RGBA($InDataT)), using img: ^ImageBeforeT) -> ImageAfterT {
+reinterpret_image_rgba_discard :: proc($ImageAfterT: typeid/Image2(RGBA($OutDataT)), $ImageBeforeT: typeid/Image2(RGBA($InDataT)), using img: ^ImageBeforeT, thread_count := 0, pool: ^thread.Pool = nil) -> ImageAfterT {
     defer delete(data);
-    return reinterpret_image_rgba(ImageAfterT, ImageBeforeT, img);
+    return reinterpret_image_rgba(ImageAfterT, ImageBeforeT, img, thread_count, pool);
 }
 
-reinterpret_image_bgr :: proc($ImageAfterT: typeid/Image2(BGR($OutDataT)), $ImageBeforeT: typeid/Image2(BGR($InDataT)), using img: ^ImageBeforeT) -> ImageAfterT {
+/**
+ * @brief the pixels are converted in parallel row tiles by the vector kernels (@see convert_image)
+ * @param pool already started pool reused across calls, a pool is created for the call when nil
+ */
+reinterpret_image_bgr :: proc($ImageAfterT: typeid/Image2(BGR($OutDataT)), $ImageBeforeT: typeid/Image2(BGR($InDataT)), using img: ^ImageBeforeT, thread_count := 0, pool: ^thread.Pool = nil) -> ImageAfterT {
     new_img: ImageAfterT;
     new_img.data = make([]BGR(OutDataT), size.x * size.y);
     new_img.size = size;
     new_img.info = BGR_UUID | (query_uUUID(OutDataT) << 4);
 
-    for j in 0..<len(data) do new_img.data[j] = reinterpret_pixel_bgr(BGR(OutDataT), BGR(InDataT), data[j]);
+    convert_image_bgr(&new_img, img, thread_count, pool);
 
     return new_img;
 }
 
-reinterpret_image_rgba :: proc($ImageAfterT: typeid/Image2(RGBA($OutDataT)), $ImageBeforeT: typeid/Image2(RGBA($InDataT)), using img: ^ImageBeforeT) -> ImageAfterT {
+reinterpret_image_rgba :: proc($ImageAfterT: typeid/Image2(RGBA($OutDataT)), $ImageBeforeT: typeid/Image2(RGBA($InDataT)), using img: ^ImageBeforeT, thread_count := 0, pool: ^thread.Pool = nil) -> ImageAfterT {
     new_img: ImageAfterT;
     new_img.data = make([]RGBA(OutDataT), size.x * size.y);
     new_img.size = size;
-    new_img.info = BGR_UUID | (query_uUUID(OutDataT) << 4);
+    new_img.info = RGBA_UUID | (query_uUUID(OutDataT) << 4);
 
-    for j in 0..<len(data) do new_img.data[j] = reinterpret_pixel_rgba(RGBA(OutDataT), RGBA(InDataT), data[j]);
+    convert_image_rgba(&new_img, img, thread_count, pool);
 
     return new_img;
 }
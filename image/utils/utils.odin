@@ -3,6 +3,7 @@ package utils
 import "core:io"
 import "core:log"
 import "core:os"
+import "core:thread"
 
 _4BYTES :: [4]byte;
 _2BYTES :: [2]byte;
@@ -182,4 +183,16 @@ Palette :: struct($N: int) {
 Palette256 :: Palette(256);
 Palette64  :: Palette(64);
 Palette16  :: Palette(16);
-Palette2   :: Palette(2);
\ No newline at end of file
+Palette2   :: Palette(2);
+
+/* THREAD POOL */
+/**
+ * @brief runs the tasks added to the started "pool" and returns once all of them are done, the calling thread takes waiting tasks too
+ * @note the pool keeps running, so that a pool started once can be handed to every parallel step of a job (@see image.parallel_tiles, zlib.compress_parallel)
+ */
+pool_run_tasks :: proc(pool: ^thread.Pool) {
+    for task in thread.pool_pop_waiting(pool) do thread.pool_do_work(pool, task);
+    for thread.pool_num_outstanding(pool) > 0 do thread.yield();
+    for _ in thread.pool_pop_done(pool) {}
+}
+/*! THREAD POOL */
@@ -0,0 +1,600 @@
+package zlib
+
+import "core:mem"
+
+/* DEFLATE (RFC 1951) ENCODER */
+
+WINDOW_SIZE :: 1 << 15;
+WINDOW_MASK :: WINDOW_SIZE - 1;
+HASH_BITS   :: 15;
+HASH_SIZE   :: 1 << HASH_BITS;
+MIN_MATCH   :: 3;
+MAX_MATCH   :: 258;
+
+MAX_BLOCK_TOKENS      :: 1 << 15; // tokens gathered before a block is emitted
+STORED_BLOCK_MAX_SIZE :: (1 << 16) - 1;
+
+LITLEN_SYMBOLS  :: 286;
+DIST_SYMBOLS    :: 30;
+CODELEN_SYMBOLS :: 19;
+END_OF_BLOCK    :: 256;
+MAX_CODE_LENGTH    :: 15;
+MAX_CODELEN_LENGTH :: 7;
+
+LEVEL_STORED  :: 0;
+LEVEL_FASTEST :: 1;
+LEVEL_DEFAULT :: 6;
+LEVEL_BEST    :: 9;
+
+LENGTH_BASE := [29]u16 {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+LENGTH_EXTRA := [29]u8 {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+};
+DIST_BASE := [30]u16 {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+DIST_EXTRA := [30]u8 {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+};
+CODELEN_ORDER := [CODELEN_SYMBOLS]u8 {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+};
+
+/**
+ * @brief LZ77 parameters per compression level (same spirit as zlib's configuration_table)
+ */
+Deflate_Config :: struct {
+    max_lazy:    int,  // greedy levels: longest match whose positions are still inserted into the hash chains; lazy levels: do not look for a better match past this length
+    nice_length: int,  // stop searching once a match this long is found
+    max_chain:   int,  // how many hash chain links are followed
+    lazy:        bool, // lazy matching (check whether the next position has a better match)
+}
+
+DEFLATE_CONFIGS := [10]Deflate_Config {
+    { 0,   0,   0,    false }, // stored
+    { 4,   8,   4,    false },
+    { 5,   16,  8,    false },
+    { 6,   32,  32,   false },
+    { 4,   16,  16,   true  },
+    { 16,  32,  32,   true  },
+    { 16,  128, 128,  true  },
+    { 32,  128, 256,  true  },
+    { 128, 258, 1024, true  },
+    { 258, 258, 4096, true  },
+};
+
+/* BIT WRITER */
+Bit_Writer :: struct {
+    out:   ^[dynamic]u8,
+    bits:  u64,
+    count: uint,
+}
+
+write_bits :: #force_inline proc(using writer: ^Bit_Writer, value: u32, length: uint) {
+    bits |= u64(value) << count;
+    count += length;
+    if count >= 32 {
+        append(out, u8(bits), u8(bits >> 8), u8(bits >> 16), u8(bits >> 24));
+        bits >>= 32;
+        count -= 32;
+    }
+}
+
+align_to_byte :: proc(using writer: ^Bit_Writer) {
+    for count > 0 {
+        append(out, u8(bits));
+        bits >>= 8;
+        count = count > 8 ? count - 8 : 0;
+    }
+    bits = 0;
+}
+/*! BIT WRITER */
+
+/* HUFFMAN */
+/**
+ * @brief builds length limited huffman code lengths out of symbol frequencies
+ * @note when the tree is too deep, frequencies are flattened and the tree is rebuilt (simpler than package-merge, only marginally worse)
+ */
+build_code_lengths :: proc(freqs: []u32, lengths: []u8, limit: u8) {
+    MAX_SYMBOLS :: 288;
+    assert(len(freqs) <= MAX_SYMBOLS && len(lengths) >= len(freqs));
+
+    weights: [MAX_SYMBOLS]u32;
+    copy(weights[:], freqs);
+    mem.zero_slice(lengths);
+
+    for {
+        leaves: [MAX_SYMBOLS]u16;
+        leaf_count := 0;
+        for w, symbol in weights[:len(freqs)] {
+            if w == 0 do continue;
+            leaves[leaf_count] = u16(symbol);
+            leaf_count += 1;
+        }
+
+        // deflate decoders want at least two codes, a lone symbol gets a sibling
+        if leaf_count == 0 {
+            lengths[0], lengths[1] = 1, 1;
+            return;
+        }
+        if leaf_count == 1 {
+            lengths[leaves[0]] = 1;
+            lengths[leaves[0] == 0 ? 1 : 0] = 1;
+            return;
+        }
+
+        // leaves sorted by weight (insertion sort, there are at most 288 of them)
+        for i in 1..<leaf_count {
+            leaf := leaves[i];
+            j := i;
+            for j > 0 && weights[leaves[j - 1]] > weights[leaf] {
+                leaves[j] = leaves[j - 1];
+                j -= 1;
+            }
+            leaves[j] = leaf;
+        }
+
+        // two-queue huffman construction: nodes [0, leaf_count) are leaves, the rest are internal nodes in creation order
+        node_weight: [2 * MAX_SYMBOLS]u32;
+        node_parent: [2 * MAX_SYMBOLS]int;
+        node_depth:  [2 * MAX_SYMBOLS]u8;
+        for i in 0..<leaf_count do node_weight[i] = weights[leaves[i]];
+
+        next_leaf, next_internal, node_count := 0, leaf_count, leaf_count;
+        for _ in 0..<leaf_count - 1 {
+            children: [2]int;
+            for &child in children {
+                if next_leaf < leaf_count && (next_internal >= node_count || node_weight[next_leaf] <= node_weight[next_internal]) {
+                    child = next_leaf;
+                    next_leaf += 1;
+                } else {
+                    child = next_internal;
+                    next_internal += 1;
+                }
+            }
+            node_weight[node_count] = node_weight[children[0]] + node_weight[children[1]];
+            node_parent[children[0]] = node_count;
+            node_parent[children[1]] = node_count;
+            node_count += 1;
+        }
+
+        // parents are always created after their children, so depths can be resolved from the root down
+        node_depth[node_count - 1] = 0;
+        for i := node_count - 2; i >= 0; i -= 1 do node_depth[i] = node_depth[node_parent[i]] + 1;
+
+        max_length: u8 = 0;
+        for i in 0..<leaf_count {
+            lengths[leaves[i]] = node_depth[i];
+            max_length = max(max_length, node_depth[i]);
+        }
+        if max_length <= limit do return;
+
+        for &w in weights[:len(freqs)] do if w > 0 do w = (w >> 1) | 1;
+        mem.zero_slice(lengths);
+    }
+}
+
+reverse_bits :: #force_inline proc "contextless" (code: u16, length: u8) -> u16 {
+    code := code;
+    reversed: u16 = 0;
+    for _ in 0..<length {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    return reversed;
+}
+
+/**
+ * @brief canonical huffman codes (RFC 1951, 3.2.2), already bit-reversed since deflate writes them LSB first
+ */
+build_codes :: proc "contextless" (lengths: []u8, codes: []u16) {
+    length_count: [MAX_CODE_LENGTH + 1]u16;
+    for l in lengths do length_count[l] += 1;
+    length_count[0] = 0;
+
+    next_code: [MAX_CODE_LENGTH + 1]u16;
+    code: u16 = 0;
+    for bits in 1..=MAX_CODE_LENGTH {
+        code = (code + length_count[bits - 1]) << 1;
+        next_code[bits] = code;
+    }
+
+    for l, symbol in lengths {
+        if l == 0 do continue;
+        codes[symbol] = reverse_bits(next_code[l], l);
+        next_code[l] += 1;
+    }
+}
+/*! HUFFMAN */
+
+/* DEFLATER */
+Token :: struct {
+    dist:  u16, // 0 for literals
+    value: u16, // literal byte or match length
+}
+
+Deflater :: struct {
+    writer: Bit_Writer,
+    config: Deflate_Config,
+
+    head: []i32,
+    prev: []i32,
+
+    tokens: [dynamic]Token,
+    block_begin: int, // input offset the pending tokens start at (needed when the block ends up stored)
+
+    litlen_freq: [LITLEN_SYMBOLS]u32,
+    dist_freq:   [DIST_SYMBOLS]u32,
+
+    length_code: [MAX_MATCH + 1]u8,
+    dist_code:   [512]u8,
+
+    fixed_litlen_lengths: [288]u8,
+    fixed_litlen_codes:   [288]u16,
+    fixed_dist_lengths:   [DIST_SYMBOLS]u8,
+    fixed_dist_codes:     [DIST_SYMBOLS]u16,
+}
+
+@(private)
+_init_deflater :: proc(d: ^Deflater, out: ^[dynamic]u8, level: int, allocator := context.allocator) {
+    d.writer = { out = out, };
+    d.config = DEFLATE_CONFIGS[clamp(level, LEVEL_STORED, LEVEL_BEST)];
+
+    d.head = make([]i32, HASH_SIZE, allocator);
+    d.prev = make([]i32, WINDOW_SIZE, allocator);
+    for &h in d.head do h = -1;
+    for &p in d.prev do p = -1;
+    d.tokens = make([dynamic]Token, 0, MAX_BLOCK_TOKENS, allocator);
+
+    for code in 0..<len(LENGTH_BASE) {
+        base := int(LENGTH_BASE[code]);
+        for length in base ..< min(base + (1 << LENGTH_EXTRA[code]), MAX_MATCH + 1) do d.length_code[length] = u8(code);
+    }
+    d.length_code[MAX_MATCH] = u8(len(LENGTH_BASE) - 1); // 258 has its own code even though 227 + 31 would cover it
+    for code in 0..<len(DIST_BASE) {
+        base := int(DIST_BASE[code]);
+        for dist in base ..< base + (1 << DIST_EXTRA[code]) do d.dist_code[_dist_index(dist)] = u8(code);
+    }
+
+    for &l, symbol in d.fixed_litlen_lengths {
+        switch symbol {
+            case 0..=143:   l = 8;
+            case 144..=255: l = 9;
+            case 256..=279: l = 7;
+            case:           l = 8;
+        }
+    }
+    for &l in d.fixed_dist_lengths do l = 5;
+    build_codes(d.fixed_litlen_lengths[:], d.fixed_litlen_codes[:]);
+    build_codes(d.fixed_dist_lengths[:], d.fixed_dist_codes[:]);
+}
+
+/**
+ * @brief readies a deflater of '_init_deflater' for another band, nothing is allocated (the code tables do not depend on the band)
+ */
+@(private)
+_reset_deflater :: proc(d: ^Deflater, out: ^[dynamic]u8, level: int) {
+    d.writer = { out = out, };
+    d.config = DEFLATE_CONFIGS[clamp(level, LEVEL_STORED, LEVEL_BEST)];
+    for &h in d.head do h = -1;
+    for &p in d.prev do p = -1;
+    clear(&d.tokens);
+    d.block_begin = 0;
+    d.litlen_freq = {};
+    d.dist_freq = {};
+}
+
+@(private)
+_dump_deflater :: proc(d: ^Deflater, allocator := context.allocator) {
+    delete(d.head, allocator);
+    delete(d.prev, allocator);
+    delete(d.tokens);
+}
+
+@(private)
+_dist_index :: #force_inline proc "contextless" (dist: int) -> int {
+    return dist <= 256 ? dist - 1 : 256 + ((dist - 1) >> 7);
+}
+
+@(private)
+_hash :: #force_inline proc "contextless" (data: []u8, pos: int) -> int {
+    v := u32(data[pos]) | u32(data[pos + 1]) << 8 | u32(data[pos + 2]) << 16;
+    return int((v * 2654435761) >> (32 - HASH_BITS));
+}
+
+@(private)
+_insert :: #force_inline proc "contextless" (d: ^Deflater, data: []u8, pos: int) {
+    h := _hash(data, pos);
+    d.prev[pos & WINDOW_MASK] = d.head[h];
+    d.head[h] = i32(pos);
+}
+
+/**
+ * @note has to be called before "pos" itself is inserted, otherwise it would match itself
+ * @return (0, 0) when nothing longer than "prev_length" has been found
+ */
+@(private)
+_longest_match :: proc "contextless" (d: ^Deflater, data: []u8, pos, end: int, prev_length: int) -> (best_length: int, best_dist: int) {
+    max_length := min(MAX_MATCH, end - pos);
+    best_length = max(prev_length, MIN_MATCH - 1);
+    if best_length >= max_length do return 0, 0;
+
+    nice_length := min(d.config.nice_length, max_length);
+    chain := d.config.max_chain;
+    limit := pos - (WINDOW_SIZE - 1); // older positions might already be overwritten inside of "prev"
+
+    candidate := int(d.head[_hash(data, pos)]);
+    for candidate >= 0 && candidate >= limit && chain > 0 {
+        if data[candidate + best_length] == data[pos + best_length] && data[candidate] == data[pos] && data[candidate + 1] == data[pos + 1] {
+            length := 2;
+            for length < max_length && data[candidate + length] == data[pos + length] do length += 1;
+            if length > best_length {
+                best_length = length;
+                best_dist = pos - candidate;
+                if length >= nice_length do break;
+            }
+        }
+        next := int(d.prev[candidate & WINDOW_MASK]);
+        if next >= candidate do break;
+        candidate = next;
+        chain -= 1;
+    }
+
+    if best_dist == 0 do return 0, 0;
+    return;
+}
+
+@(private)
+_emit_literal :: #force_inline proc(d: ^Deflater, literal: u8) {
+    append(&d.tokens, Token { 0, u16(literal) });
+    d.litlen_freq[literal] += 1;
+}
+
+@(private)
+_emit_match :: #force_inline proc(d: ^Deflater, length, dist: int) {
+    append(&d.tokens, Token { u16(dist), u16(length) });
+    d.litlen_freq[257 + int(d.length_code[length])] += 1;
+    d.dist_freq[d.dist_code[_dist_index(dist)]] += 1;
+}
+
+@(private)
+_write_stored :: proc(w: ^Bit_Writer, data: []u8, final: bool) {
+    data := data;
+    for {
+        size := min(len(data), STORED_BLOCK_MAX_SIZE);
+        last := size == len(data);
+        write_bits(w, final && last ? 1 : 0, 1);
+        write_bits(w, 0, 2);
+        align_to_byte(w);
+        append(w.out, u8(size), u8(size >> 8), u8(~size), u8(~size >> 8));
+        append(w.out, ..data[:size]);
+        data = data[size:];
+        if last do break;
+    }
+}
+
+@(private)
+_write_tokens :: proc(d: ^Deflater, litlen_lengths: []u8, litlen_codes: []u16, dist_lengths: []u8, dist_codes: []u16) {
+    w := &d.writer;
+    for token in d.tokens {
+        if token.dist == 0 {
+            write_bits(w, u32(litlen_codes[token.value]), uint(litlen_lengths[token.value]));
+            continue;
+        }
+        length_code := int(d.length_code[token.value]);
+        symbol := 257 + length_code;
+        write_bits(w, u32(litlen_codes[symbol]), uint(litlen_lengths[symbol]));
+        if LENGTH_EXTRA[length_code] > 0 do write_bits(w, u32(token.value - LENGTH_BASE[length_code]), uint(LENGTH_EXTRA[length_code]));
+
+        dist_code := int(d.dist_code[_dist_index(int(token.dist))]);
+        write_bits(w, u32(dist_codes[dist_code]), uint(dist_lengths[dist_code]));
+        if DIST_EXTRA[dist_code] > 0 do write_bits(w, u32(token.dist - DIST_BASE[dist_code]), uint(DIST_EXTRA[dist_code]));
+    }
+    write_bits(w, u32(litlen_codes[END_OF_BLOCK]), uint(litlen_lengths[END_OF_BLOCK]));
+}
+
+@(private)
+_data_bits :: proc "contextless" (d: ^Deflater, litlen_lengths: []u8, dist_lengths: []u8) -> (bits: int) {
+    for freq, symbol in d.litlen_freq {
+        if freq == 0 do continue;
+        bits += int(freq) * int(litlen_lengths[symbol]);
+        if symbol > END_OF_BLOCK do bits += int(freq) * int(LENGTH_EXTRA[symbol - 257]);
+    }
+    for freq, symbol in d.dist_freq {
+        if freq == 0 do continue;
+        bits += int(freq) * (int(dist_lengths[symbol]) + int(DIST_EXTRA[symbol]));
+    }
+    return;
+}
+
+/**
+ * @brief emits the gathered tokens as the cheapest of dynamic/fixed/stored block
+ */
+@(private)
+_flush_block :: proc(d: ^Deflater, data: []u8, block_end: int, final: bool) {
+    d.litlen_freq[END_OF_BLOCK] += 1;
+
+    litlen_lengths: [LITLEN_SYMBOLS]u8;
+    litlen_codes:   [LITLEN_SYMBOLS]u16;
+    dist_lengths:   [DIST_SYMBOLS]u8;
+    dist_codes:     [DIST_SYMBOLS]u16;
+    build_code_lengths(d.litlen_freq[:], litlen_lengths[:], MAX_CODE_LENGTH);
+    build_code_lengths(d.dist_freq[:], dist_lengths[:], MAX_CODE_LENGTH);
+    build_codes(litlen_lengths[:], litlen_codes[:]);
+    build_codes(dist_lengths[:], dist_codes[:]);
+
+    hlit := LITLEN_SYMBOLS;
+    for hlit > 257 && litlen_lengths[hlit - 1] == 0 do hlit -= 1;
+    hdist := DIST_SYMBOLS;
+    for hdist > 1 && dist_lengths[hdist - 1] == 0 do hdist -= 1;
+
+    // run length encoded code lengths (symbol | extra bits value << 8)
+    all_lengths: [LITLEN_SYMBOLS + DIST_SYMBOLS]u8;
+    copy(all_lengths[:hlit], litlen_lengths[:hlit]);
+    copy(all_lengths[hlit:hlit + hdist], dist_lengths[:hdist]);
+    rle: [LITLEN_SYMBOLS + DIST_SYMBOLS]u16;
+    rle_count := 0;
+    codelen_freq: [CODELEN_SYMBOLS]u32;
+    {
+        lengths := all_lengths[:hlit + hdist];
+        for i := 0; i < len(lengths); {
+            length := lengths[i];
+            run := 1;
+            for i + run < len(lengths) && lengths[i + run] == length do run += 1;
+            i += run;
+
+            if length == 0 {
+                for run >= 11 {
+                    r := min(run, 138);
+                    rle[rle_count] = 18 | u16(r - 11) << 8; rle_count += 1;
+                    run -= r;
+                }
+                if run >= 3 {
+                    rle[rle_count] = 17 | u16(run - 3) << 8; rle_count += 1;
+                    run = 0;
+                }
+            } else {
+                rle[rle_count] = u16(length); rle_count += 1;
+                run -= 1;
+                for run >= 3 {
+                    r := min(run, 6);
+                    rle[rle_count] = 16 | u16(r - 3) << 8; rle_count += 1;
+                    run -= r;
+                }
+            }
+            for ; run > 0; run -= 1 {
+                rle[rle_count] = u16(length); rle_count += 1;
+            }
+        }
+        for symbol in rle[:rle_count] do codelen_freq[symbol & 0xff] += 1;
+    }
+
+    codelen_lengths: [CODELEN_SYMBOLS]u8;
+    codelen_codes:   [CODELEN_SYMBOLS]u16;
+    build_code_lengths(codelen_freq[:], codelen_lengths[:], MAX_CODELEN_LENGTH);
+    build_codes(codelen_lengths[:], codelen_codes[:]);
+    hclen := CODELEN_SYMBOLS;
+    for hclen > 4 && codelen_lengths[CODELEN_ORDER[hclen - 1]] == 0 do hclen -= 1;
+
+    CODELEN_EXTRA := [3]u8 { 2, 3, 7 };
+    dynamic_bits := 3 + 5 + 5 + 4 + 3 * hclen + _data_bits(d, litlen_lengths[:], dist_lengths[:]);
+    for symbol in rle[:rle_count] {
+        s := symbol & 0xff;
+        dynamic_bits += int(codelen_lengths[s]);
+        if s >= 16 do dynamic_bits += int(CODELEN_EXTRA[s - 16]);
+    }
+    fixed_bits := 3 + _data_bits(d, d.fixed_litlen_lengths[:], d.fixed_dist_lengths[:]);
+    stored_size := block_end - d.block_begin;
+    stored_bits := (stored_size + 5 * max(1, (stored_size + STORED_BLOCK_MAX_SIZE - 1) / STORED_BLOCK_MAX_SIZE)) * 8 + 7;
+
+    w := &d.writer;
+    if stored_bits <= dynamic_bits && stored_bits <= fixed_bits {
+        _write_stored(w, data[d.block_begin:block_end], final);
+    } else if fixed_bits <= dynamic_bits {
+        write_bits(w, final ? 1 : 0, 1);
+        write_bits(w, 1, 2);
+        _write_tokens(d, d.fixed_litlen_lengths[:], d.fixed_litlen_codes[:], d.fixed_dist_lengths[:], d.fixed_dist_codes[:]);
+    } else {
+        write_bits(w, final ? 1 : 0, 1);
+        write_bits(w, 2, 2);
+        write_bits(w, u32(hlit - 257), 5);
+        write_bits(w, u32(hdist - 1), 5);
+        write_bits(w, u32(hclen - 4), 4);
+        for i in 0..<hclen do write_bits(w, u32(codelen_lengths[CODELEN_ORDER[i]]), 3);
+        for symbol in rle[:rle_count] {
+            s := symbol & 0xff;
+            write_bits(w, u32(codelen_codes[s]), uint(codelen_lengths[s]));
+            if s >= 16 do write_bits(w, u32(symbol >> 8), uint(CODELEN_EXTRA[s - 16]));
+        }
+        _write_tokens(d, litlen_lengths[:], litlen_codes[:], dist_lengths[:], dist_codes[:]);
+    }
+
+    clear(&d.tokens);
+    d.litlen_freq = {};
+    d.dist_freq = {};
+    d.block_begin = block_end;
+}
+
+/**
+ * @brief deflates data[begin:end] and appends it to "out"
+ * @note bytes of data[:begin] (up to the window size) are used as the dictionary without being emitted (pigz style priming),
+ *       so consecutive bands compressed independently still reference each other
+ * @note a non final band ends with an empty stored block (sync flush), therefore the output of every band is byte aligned and the bands can be simply concatenated
+ */
+deflate_band :: proc(out: ^[dynamic]u8, data: []u8, begin, end: int, level := LEVEL_DEFAULT, final := true) {
+    if level <= LEVEL_STORED {
+        writer := Bit_Writer { out = out, };
+        _write_stored(&writer, data[begin:end], final);
+        align_to_byte(&writer);
+        return;
+    }
+
+    d: Deflater;
+    _init_deflater(&d, out, level);
+    defer _dump_deflater(&d);
+    _deflate_band(&d, data, begin, end, final);
+}
+
+/**
+ * @brief body of 'deflate_band' on a deflater initialized by the caller (@see _init_deflater), the deflater is not allocated nor freed here
+ */
+@(private)
+_deflate_band :: proc(d: ^Deflater, data: []u8, begin, end: int, final: bool) {
+    d.block_begin = begin;
+
+    for p in max(0, begin - WINDOW_SIZE) ..< min(begin, len(data) - (MIN_MATCH - 1)) do _insert(d, data, p);
+
+    pos := begin;
+    if !d.config.lazy {
+        for pos < end {
+            length, dist := 0, 0;
+            if pos + MIN_MATCH <= end {
+                length, dist = _longest_match(d, data, pos, end, 0);
+                _insert(d, data, pos);
+            }
+            if length >= MIN_MATCH {
+                _emit_match(d, length, dist);
+                if length <= d.config.max_lazy {
+                    for p in pos + 1 ..< pos + length do if p + MIN_MATCH <= end do _insert(d, data, p);
+                }
+                pos += length;
+            } else {
+                _emit_literal(d, data[pos]);
+                pos += 1;
+            }
+            if len(d.tokens) >= MAX_BLOCK_TOKENS do _flush_block(d, data, pos, false);
+        }
+    } else {
+        prev_length, prev_dist := 0, 0;
+        match_available := false; // literal of pos - 1 has not been emitted yet
+        for pos < end {
+            length, dist := 0, 0;
+            if pos + MIN_MATCH <= end {
+                if prev_length < d.config.max_lazy do length, dist = _longest_match(d, data, pos, end, prev_length);
+                _insert(d, data, pos);
+            }
+            if prev_length >= MIN_MATCH && length <= prev_length {
+                // the match starting at the previous position wins
+                _emit_match(d, prev_length, prev_dist);
+                match_end := pos - 1 + prev_length;
+                for p in pos + 1 ..< match_end do if p + MIN_MATCH <= end do _insert(d, data, p);
+                pos = match_end;
+                prev_length, match_available = 0, false;
+            } else {
+                if match_available do _emit_literal(d, data[pos - 1]);
+                match_available = true;
+                prev_length, prev_dist = length, dist;
+                pos += 1;
+            }
+            if len(d.tokens) >= MAX_BLOCK_TOKENS do _flush_block(d, data, match_available ? pos - 1 : pos, false);
+        }
+        if match_available do _emit_literal(d, data[pos - 1]);
+    }
+
+    _flush_block(d, data, end, final);
+    if !final do _write_stored(&d.writer, {}, false); // sync flush
+    align_to_byte(&d.writer);
+}
+/*! DEFLATER */
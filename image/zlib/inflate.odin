@@ -0,0 +1,362 @@
+package zlib
+
+import "core:io"
+
+/* INFLATE (RFC 1951) STREAMING DECODER */
+
+INFLATE_INPUT_BUFFER_SIZE :: 4096;
+
+Inflate_Error :: enum {
+    None,
+    UnexpectedEOF,       // input ended in the middle of the stream
+    InvalidHeader,       // not a deflate stream with 32K window, bad FCHECK or preset dictionary
+    InvalidBlockType,
+    InvalidStoredLength, // LEN and NLEN of a stored block do not match
+    InvalidHuffmanCode,  // over-subscribed code or a code which has not been assigned to any symbol
+    InvalidDistance,     // distance pointing before the beginning of the output
+    AdlerMismatch,
+}
+
+@(private)
+Inflate_State :: enum u8 {
+    Header,
+    BlockHeader,
+    Stored,
+    Huffman,
+    Trailer,
+    Done,
+}
+
+/**
+ * @brief single level decoding table, indexed by the next "bits" bits of the input (LSB first)
+ * @note entry is (symbol << 4) | code length, zero marks bit patterns not assigned to any code
+ */
+Huffman_Table :: struct {
+    entries: [1 << MAX_CODE_LENGTH]u16,
+    bits:    uint,
+}
+
+/**
+ * @brief pull based zlib decoder: the compressed data is read from "reader" only when more output is asked for,
+ *        so the memory needed is the 32K window plus the input buffer regardless of the stream size
+ * @note the struct is large (decoding tables + window), allocate it with 'new'
+ */
+Inflater :: struct {
+    reader: io.Reader,
+
+    input:       [INFLATE_INPUT_BUFFER_SIZE]u8,
+    input_pos:   int,
+    input_len:   int,
+    input_eof:   bool,
+
+    bits:  u64,
+    count: uint,
+
+    window:   [WINDOW_SIZE]u8,
+    produced: int, // total output so far, window position is produced & WINDOW_MASK
+
+    state:       Inflate_State,
+    final_block: bool,
+    stored_remaining: int,
+    copy_length: int,
+    copy_dist:   int,
+    adler:       u32,
+
+    litlen: Huffman_Table,
+    dist:   Huffman_Table,
+}
+
+inflater_init :: proc(inf: ^Inflater, reader: io.Reader) {
+    inf.reader = reader;
+    inf.input_pos, inf.input_len, inf.input_eof = 0, 0, false;
+    inf.bits, inf.count = 0, 0;
+    inf.produced = 0;
+    inf.state = .Header;
+    inf.final_block = false;
+    inf.stored_remaining, inf.copy_length, inf.copy_dist = 0, 0, 0;
+    inf.adler = 1;
+}
+
+inflater_done :: #force_inline proc "contextless" (inf: ^Inflater) -> bool {
+    return inf.state == .Done;
+}
+
+/* BIT READER */
+@(private)
+_next_input_byte :: #force_inline proc(inf: ^Inflater) -> (value: u8, ok: bool) {
+    if inf.input_pos == inf.input_len {
+        if inf.input_eof do return 0, false;
+        n, _ := io.read(inf.reader, inf.input[:]); // a short read together with an error is reported by the next (empty) read
+        if n <= 0 {
+            inf.input_eof = true;
+            return 0, false;
+        }
+        inf.input_pos, inf.input_len = 0, n;
+    }
+    value = inf.input[inf.input_pos];
+    inf.input_pos += 1;
+    return value, true;
+}
+
+/**
+ * @brief tops the bit buffer up to at least 57 bits, which covers a whole length/distance pair
+ * @note past the end of the input the buffer is not topped up, consuming more bits than there are is reported by '_consume'
+ */
+@(private)
+_refill :: #force_inline proc(inf: ^Inflater) {
+    for inf.count <= 56 {
+        value, ok := _next_input_byte(inf);
+        if !ok do return;
+        inf.bits |= u64(value) << inf.count;
+        inf.count += 8;
+    }
+}
+
+@(private)
+_consume :: #force_inline proc "contextless" (inf: ^Inflater, length: uint) -> (value: u32, err: Inflate_Error) {
+    if length > inf.count do return 0, .UnexpectedEOF;
+    value = u32(inf.bits & ((u64(1) << length) - 1));
+    inf.bits >>= length;
+    inf.count -= length;
+    return value, .None;
+}
+
+@(private)
+_read_bits :: #force_inline proc(inf: ^Inflater, length: uint) -> (u32, Inflate_Error) {
+    if inf.count < length do _refill(inf);
+    return _consume(inf, length);
+}
+
+@(private)
+_align_to_byte :: #force_inline proc "contextless" (inf: ^Inflater) {
+    drop := inf.count & 7;
+    inf.bits >>= drop;
+    inf.count -= drop;
+}
+
+@(private)
+_decode_symbol :: #force_inline proc "contextless" (inf: ^Inflater, table: ^Huffman_Table) -> (symbol: int, err: Inflate_Error) {
+    entry := table.entries[inf.bits & ((u64(1) << table.bits) - 1)];
+    length := uint(entry & 0xf);
+    if length == 0 do return 0, .InvalidHuffmanCode;
+    if length > inf.count do return 0, .UnexpectedEOF;
+    inf.bits >>= length;
+    inf.count -= length;
+    return int(entry >> 4), .None;
+}
+/*! BIT READER */
+
+@(private)
+_build_table :: proc "contextless" (table: ^Huffman_Table, lengths: []u8) -> Inflate_Error {
+    length_count: [MAX_CODE_LENGTH + 1]int;
+    max_length: uint = 1;
+    for l in lengths {
+        length_count[l] += 1;
+        if l > 0 do max_length = max(max_length, uint(l));
+    }
+    length_count[0] = 0;
+
+    left := 1;
+    for bits in 1..=MAX_CODE_LENGTH {
+        left = (left << 1) - length_count[bits];
+        if left < 0 do return .InvalidHuffmanCode; // over-subscribed
+    }
+
+    table.bits = max_length;
+    size := 1 << max_length;
+    for &e in table.entries[:size] do e = 0;
+
+    codes: [LITLEN_SYMBOLS + 2]u16;
+    build_codes(lengths, codes[:len(lengths)]);
+    for l, symbol in lengths {
+        if l == 0 do continue;
+        entry := u16(symbol) << 4 | u16(l);
+        for i := int(codes[symbol]); i < size; i += 1 << l do table.entries[i] = entry;
+    }
+    return .None;
+}
+
+@(private)
+_fixed_tables :: proc "contextless" (inf: ^Inflater) {
+    lengths: [288]u8;
+    for &l, symbol in lengths {
+        switch symbol {
+            case 0..=143:   l = 8;
+            case 144..=255: l = 9;
+            case 256..=279: l = 7;
+            case:           l = 8;
+        }
+    }
+    _build_table(&inf.litlen, lengths[:]);
+    dist_lengths: [DIST_SYMBOLS + 2]u8;
+    for &l in dist_lengths do l = 5;
+    _build_table(&inf.dist, dist_lengths[:]);
+}
+
+@(private)
+_dynamic_tables :: proc(inf: ^Inflater) -> Inflate_Error {
+    hlit  := int(_read_bits(inf, 5) or_return) + 257;
+    hdist := int(_read_bits(inf, 5) or_return) + 1;
+    hclen := int(_read_bits(inf, 4) or_return) + 4;
+    if hlit > LITLEN_SYMBOLS || hdist > DIST_SYMBOLS do return .InvalidHuffmanCode;
+
+    codelen_lengths: [CODELEN_SYMBOLS]u8;
+    for i in 0..<hclen do codelen_lengths[CODELEN_ORDER[i]] = u8(_read_bits(inf, 3) or_return);
+    codelen_table: Huffman_Table;
+    _build_table(&codelen_table, codelen_lengths[:]) or_return;
+
+    lengths: [LITLEN_SYMBOLS + DIST_SYMBOLS]u8;
+    for i := 0; i < hlit + hdist; {
+        _refill(inf);
+        symbol := _decode_symbol(inf, &codelen_table) or_return;
+        if symbol < 16 {
+            lengths[i] = u8(symbol);
+            i += 1;
+            continue;
+        }
+        value: u8 = 0;
+        repeat: int;
+        switch symbol {
+            case 16:
+                if i == 0 do return .InvalidHuffmanCode;
+                value = lengths[i - 1];
+                repeat = 3 + int(_consume(inf, 2) or_return);
+            case 17:
+                repeat = 3 + int(_consume(inf, 3) or_return);
+            case:
+                repeat = 11 + int(_consume(inf, 7) or_return);
+        }
+        if i + repeat > hlit + hdist do return .InvalidHuffmanCode;
+        for _ in 0..<repeat {
+            lengths[i] = value;
+            i += 1;
+        }
+    }
+    if lengths[END_OF_BLOCK] == 0 do return .InvalidHuffmanCode;
+
+    _build_table(&inf.litlen, lengths[:hlit]) or_return;
+    _build_table(&inf.dist, lengths[hlit : hlit + hdist]) or_return;
+    return .None;
+}
+
+/**
+ * @brief decodes up to len(out) bytes of the stream
+ * @return n < len(out) only once the whole stream (including the adler32 trailer) has been decoded
+ */
+inflate_read :: proc(inf: ^Inflater, out: []u8) -> (n: int, err: Inflate_Error) {
+    adler_from := 0;
+    defer inf.adler = adler32(out[adler_from:n], inf.adler);
+
+    emit :: #force_inline proc "contextless" (inf: ^Inflater, out: []u8, n: ^int, value: u8) {
+        out[n^] = value;
+        inf.window[inf.produced & WINDOW_MASK] = value;
+        inf.produced += 1;
+        n^ += 1;
+    }
+
+    for n < len(out) {
+        switch inf.state {
+            case .Header:
+                cmf := _read_bits(inf, 8) or_return;
+                flg := _read_bits(inf, 8) or_return;
+                if cmf & 0x0f != 8 || cmf >> 4 > 7 || (cmf * 256 + flg) % 31 != 0 || flg & 0x20 != 0 do return n, .InvalidHeader;
+                inf.state = .BlockHeader;
+
+            case .BlockHeader:
+                if inf.final_block {
+                    inf.state = .Trailer;
+                    continue;
+                }
+                inf.final_block = (_read_bits(inf, 1) or_return) == 1;
+                switch _read_bits(inf, 2) or_return {
+                    case 0:
+                        _align_to_byte(inf);
+                        length := _read_bits(inf, 16) or_return;
+                        nlength := _read_bits(inf, 16) or_return;
+                        if length != ~nlength & 0xffff do return n, .InvalidStoredLength;
+                        inf.stored_remaining = int(length);
+                        inf.state = .Stored;
+                    case 1:
+                        _fixed_tables(inf);
+                        inf.state = .Huffman;
+                    case 2:
+                        _dynamic_tables(inf) or_return;
+                        inf.state = .Huffman;
+                    case:
+                        return n, .InvalidBlockType;
+                }
+
+            case .Stored:
+                for inf.stored_remaining > 0 && n < len(out) {
+                    // whole bytes left in the bit buffer first, then straight from the input buffer
+                    value: u8;
+                    if inf.count >= 8 {
+                        value = u8(_consume(inf, 8) or_return);
+                    } else {
+                        ok: bool;
+                        value, ok = _next_input_byte(inf);
+                        if !ok do return n, .UnexpectedEOF;
+                    }
+                    emit(inf, out, &n, value);
+                    inf.stored_remaining -= 1;
+                }
+                if inf.stored_remaining == 0 do inf.state = .BlockHeader;
+
+            case .Huffman:
+                for n < len(out) {
+                    if inf.copy_length > 0 {
+                        count := min(inf.copy_length, len(out) - n);
+                        from := inf.produced - inf.copy_dist;
+                        for i in 0..<count do emit(inf, out, &n, inf.window[(from + i) & WINDOW_MASK]);
+                        inf.copy_length -= count;
+                        continue;
+                    }
+
+                    _refill(inf);
+                    symbol := _decode_symbol(inf, &inf.litlen) or_return;
+                    if symbol < END_OF_BLOCK {
+                        emit(inf, out, &n, u8(symbol));
+                        continue;
+                    }
+                    if symbol == END_OF_BLOCK {
+                        inf.state = .BlockHeader;
+                        break;
+                    }
+
+                    length_code := symbol - 257;
+                    if length_code >= len(LENGTH_BASE) do return n, .InvalidHuffmanCode;
+                    length := int(LENGTH_BASE[length_code]) + int(_consume(inf, uint(LENGTH_EXTRA[length_code])) or_return);
+
+                    dist_code := _decode_symbol(inf, &inf.dist) or_return;
+                    if dist_code >= len(DIST_BASE) do return n, .InvalidHuffmanCode;
+                    dist := int(DIST_BASE[dist_code]) + int(_consume(inf, uint(DIST_EXTRA[dist_code])) or_return);
+                    if dist > inf.produced || dist > WINDOW_SIZE do return n, .InvalidDistance;
+
+                    inf.copy_length, inf.copy_dist = length, dist;
+                }
+
+            case .Trailer:
+                _align_to_byte(inf);
+                expected := u32(0);
+                for _ in 0..<4 do expected = expected << 8 | (_read_bits(inf, 8) or_return);
+                inf.adler = adler32(out[adler_from:n], inf.adler);
+                adler_from = n;
+                if expected != inf.adler do return n, .AdlerMismatch;
+                inf.state = .Done;
+
+            case .Done:
+                return;
+        }
+    }
+    return;
+}
+
+/**
+ * @brief decodes (and throws away) whatever is left of the stream, up to and including the adler32 trailer
+ */
+inflate_finish :: proc(inf: ^Inflater) -> Inflate_Error {
+    scratch: [1024]u8;
+    for inf.state != .Done do inflate_read(inf, scratch[:]) or_return;
+    return .None;
+}
+/*! INFLATE (RFC 1951) STREAMING DECODER */
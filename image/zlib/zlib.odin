@@ -1 +1,202 @@
 package zlib
+
+import "base:runtime"
+import "core:os"
+import "core:thread"
+
+import "../utils"
+
+/* ZLIB (RFC 1950) STREAM */
+
+ADLER_BASE :: 65521;
+ADLER_NMAX :: 5552; // largest n for which 255n(n+1)/2 + (n+1)(BASE-1) still fits into u32
+
+DEFAULT_BAND_SIZE :: 128 * 1024;
+
+/**
+ * @brief two byte zlib header: deflate with 32K window, FLEVEL matching "level"
+ */
+zlib_header :: proc "contextless" (level: int) -> [2]u8 {
+    CMF :: 0x78;
+    flevel: u8;
+    switch {
+        case level < 2:  flevel = 0;
+        case level < 6:  flevel = 1;
+        case level == 6: flevel = 2;
+        case:            flevel = 3;
+    }
+    flg := flevel << 6;
+    flg |= u8((31 - (u32(CMF) * 256 + u32(flg)) % 31) % 31);
+    return { CMF, flg };
+}
+
+adler32 :: proc "contextless" (data: []u8, adler: u32 = 1) -> u32 {
+    a, b := adler & 0xffff, adler >> 16;
+    data := data;
+    for len(data) > 0 {
+        n := min(len(data), ADLER_NMAX);
+        for v in data[:n] {
+            a += u32(v);
+            b += a;
+        }
+        a %= ADLER_BASE;
+        b %= ADLER_BASE;
+        data = data[n:];
+    }
+    return a | (b << 16);
+}
+
+/**
+ * @brief adler32 of the concatenation A|B out of adler32(A), adler32(B) and len(B)
+ */
+adler32_combine :: proc "contextless" (adler1, adler2: u32, length2: int) -> u32 {
+    rem := u64(length2) % ADLER_BASE;
+    sum1 := u64(adler1 & 0xffff);
+    sum2 := (rem * sum1) % ADLER_BASE;
+    sum1 += u64(adler2 & 0xffff) + ADLER_BASE - 1;
+    sum2 += u64(adler1 >> 16) + u64(adler2 >> 16) + ADLER_BASE - rem;
+    if sum1 >= ADLER_BASE do sum1 -= ADLER_BASE;
+    if sum1 >= ADLER_BASE do sum1 -= ADLER_BASE;
+    if sum2 >= 2 * ADLER_BASE do sum2 -= 2 * ADLER_BASE;
+    if sum2 >= ADLER_BASE do sum2 -= ADLER_BASE;
+    return u32(sum1 | (sum2 << 16));
+}
+
+/**
+ * @brief upper bound of the deflated size of "size" bytes (stored blocks are picked whenever huffman coding would not help)
+ */
+deflate_bound :: #force_inline proc "contextless" (size: int) -> int {
+    return size + size / 4096 + 64;
+}
+
+/**
+ * @brief compresses "data" into a single zlib stream
+ */
+compress :: proc(data: []u8, level := LEVEL_DEFAULT, allocator := context.allocator) -> []u8 {
+    out := make([dynamic]u8, 0, deflate_bound(len(data)) + 6, allocator);
+    header := zlib_header(level);
+    append(&out, ..header[:]);
+    deflate_band(&out, data, 0, len(data), level, true);
+    _append_adler(&out, adler32(data));
+    return out[:];
+}
+
+@(private)
+_append_adler :: #force_inline proc(out: ^[dynamic]u8, adler: u32) {
+    append(out, u8(adler >> 24), u8(adler >> 16), u8(adler >> 8), u8(adler));
+}
+
+@(private)
+Band_Task :: struct {
+    data:  []u8,
+    begin: int,
+    end:   int,
+    level: int,
+    final: bool,
+    out:   ^[dynamic]u8,
+    adler: u32,
+}
+
+/**
+ * @brief one task per worker: bands "first", "first" + "stride", ... deflated one after the other with the same deflater
+ */
+@(private)
+Band_Worker :: struct {
+    bands:    []Band_Task,
+    first:    int,
+    stride:   int,
+    deflater: Deflater,
+}
+
+@(private)
+_compress_band_task :: proc(task: thread.Task) {
+    using worker := cast(^Band_Worker)task.data;
+    for i := first; i < len(bands); i += stride {
+        band := &bands[i];
+        if band.level <= LEVEL_STORED {
+            deflate_band(band.out, band.data, band.begin, band.end, band.level, band.final);
+        } else {
+            _reset_deflater(&deflater, band.out, band.level);
+            _deflate_band(&deflater, band.data, band.begin, band.end, band.final);
+        }
+        band.adler = adler32(band.data[band.begin:band.end]);
+    }
+}
+
+/**
+ * @brief compresses "data" as one zlib stream split into independently deflated bands (pigz style), the bands are spread over one task per thread
+ * @note the parts concatenated form a valid zlib stream: the header is a part of the first one, the adler32 trailer a part of the last one
+ * @note every band uses the 32K preceding it as its dictionary, so the ratio loss compared to 'compress' is only the block boundaries
+ * @param thread_count 0 picks the number of cores, ignored when "pool" is given
+ * @param pool already started pool the bands run on (it keeps running afterwards), a pool of "thread_count" threads is created for the call when nil
+ * @return parts allocated with "allocator" (@see dump_parts)
+ */
+compress_parallel :: proc(
+    data: []u8,
+    level := LEVEL_DEFAULT,
+    thread_count := 0,
+    band_size := DEFAULT_BAND_SIZE,
+    allocator := context.allocator,
+    pool: ^thread.Pool = nil,
+) -> [][]u8 {
+    band_size := max(band_size, WINDOW_SIZE);
+    band_count := max(1, (len(data) + band_size - 1) / band_size);
+    thread_count := thread_count <= 0 ? os.processor_core_count() : thread_count;
+    if pool != nil do thread_count = len(pool.threads) + 1; // the calling thread works too
+    thread_count = min(thread_count, band_count);
+
+    outs  := make([][dynamic]u8, band_count);
+    defer delete(outs);
+    bands := make([]Band_Task, band_count);
+    defer delete(bands);
+    for i in 0..<band_count {
+        begin := i * band_size;
+        end := min(begin + band_size, len(data));
+        // reserved upfront (on this thread) so that the tasks never call into "allocator", which might not be thread safe
+        // (the bound holds the whole band and the pending tokens are flushed before they outgrow the deflater, nothing is appended past it)
+        outs[i] = make([dynamic]u8, 0, deflate_bound(end - begin) + 6, allocator);
+        bands[i] = { data, begin, end, level, i == band_count - 1, &outs[i], 1 };
+    }
+    header := zlib_header(level);
+    append(&outs[0], ..header[:]);
+
+    // one deflater per worker, allocated here for the same reason as the outputs
+    workers := make([]Band_Worker, max(1, thread_count));
+    defer delete(workers);
+    for &worker, i in workers {
+        worker = { bands = bands, first = i, stride = len(workers), };
+        if level > LEVEL_STORED do _init_deflater(&worker.deflater, nil, level, allocator);
+    }
+    defer if level > LEVEL_STORED {
+        for &worker in workers do _dump_deflater(&worker.deflater, allocator);
+    }
+
+    if len(workers) == 1 {
+        _compress_band_task({ data = &workers[0], });
+    } else if pool != nil {
+        for &worker, i in workers do thread.pool_add_task(pool, runtime.heap_allocator(), _compress_band_task, &worker, i);
+        utils.pool_run_tasks(pool);
+    } else {
+        local_pool: thread.Pool;
+        thread.pool_init(&local_pool, runtime.heap_allocator(), len(workers));
+        defer thread.pool_destroy(&local_pool);
+        for &worker, i in workers do thread.pool_add_task(&local_pool, runtime.heap_allocator(), _compress_band_task, &worker, i);
+        thread.pool_start(&local_pool);
+        thread.pool_finish(&local_pool);
+    }
+
+    adler := bands[0].adler;
+    for band in bands[1:] do adler = adler32_combine(adler, band.adler, band.end - band.begin);
+    _append_adler(&outs[band_count - 1], adler);
+
+    parts := make([][]u8, band_count, allocator);
+    for out, i in outs do parts[i] = out[:];
+    return parts;
+}
+
+dump_parts :: proc(parts: [][]u8, allocator := context.allocator) {
+    for part in parts do delete(part, allocator);
+    delete(parts, allocator);
+}
+
+/*! ZLIB (RFC 1950) STREAM */
@@ -1,5 +1,69 @@
 package main
 
+import "core:bytes"
+import "core:fmt"
+import "core:log"
+import "core:math/rand"
+import core_zlib "core:compress/zlib"
+
+import zlib "../zlib"
+
+/**
+ * @brief compressed "data" has to inflate (with the core inflater) back to "data"
+ */
+round_trip :: proc(name: string, data: []u8, level: int, parallel: bool) {
+    compressed: [dynamic]u8;
+    defer delete(compressed);
+    if parallel {
+        parts := zlib.compress_parallel(data, level, 4, 64 * 1024);
+        defer zlib.dump_parts(parts);
+        for part in parts do append(&compressed, ..part);
+    } else {
+        stream := zlib.compress(data, level);
+        defer delete(stream);
+        append(&compressed, ..stream);
+    }
+
+    buf: bytes.Buffer;
+    defer bytes.buffer_destroy(&buf);
+    err := core_zlib.inflate(compressed[:], &buf);
+    fmt.assertf(err == nil, "\x1b[31m[%v] level %v (parallel: %v) failed to inflate: %v\x1b[0m\n", name, level, parallel, err);
+    inflated := bytes.buffer_to_bytes(&buf);
+    fmt.assertf(len(inflated) == len(data), "\x1b[31m[%v] level %v (parallel: %v) size mismatch: %v :: %v\x1b[0m\n", name, level, parallel, len(inflated), len(data));
+    for v, i in data do fmt.assertf(v == inflated[i], "\x1b[31m[%v] level %v (parallel: %v) bytes do not match at [%v]\x1b[0m\n", name, level, parallel, i);
+
+    log.infof("[%v] level %v (parallel: %v): %v -> %v bytes", name, level, parallel, len(data), len(compressed));
+}
+
 main :: proc() {
+    context.logger = log.create_console_logger();
+
+    SIZE :: 1 << 20;
+
+    random := make([]u8, SIZE);
+    defer delete(random);
+    for &v in random do v = u8(rand.uint32());
+
+    // runs, repeated phrases and a bit of noise: exercises literals, long/short matches and every block type
+    text := make([]u8, SIZE);
+    defer delete(text);
+    PHRASE :: "the quick brown fox jumps over the lazy dog ";
+    for &v, i in text {
+        switch (i / 4096) % 3 {
+            case 0: v = PHRASE[i % len(PHRASE)];
+            case 1: v = u8(i / 512);
+            case:   v = u8(rand.uint32() % 4);
+        }
+    }
+
+    empty: []u8;
+    for level in zlib.LEVEL_STORED ..= zlib.LEVEL_BEST {
+        round_trip("empty", empty, level, false);
+        round_trip("random", random, level, false);
+        round_trip("text", text, level, false);
+        round_trip("random", random, level, true);
+        round_trip("text", text, level, true);
+    }
 
-}
\ No newline at end of file
+    fmt.printf("\x1b[32mzlib round trip passed!\x1b[0m\n");
+}
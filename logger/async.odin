@@ -0,0 +1,410 @@
+package logger
+
+import "base:intrinsics"
+import "base:runtime"
+import "core:fmt"
+import "core:log"
+import "core:mem"
+import "core:os"
+import "core:strings"
+import "core:sync"
+import "core:thread"
+import "core:time"
+
+/**
+ * @brief what a producer does when its queue has no room for the message
+ */
+Full_Policy :: enum u8 {
+    Drop,  // the message is lost (the writer reports how many were), the caller never waits
+    Block, // the caller spins until the writer made room
+}
+
+Async_Options :: struct {
+    queue_size:     int,           // bytes of the queue of every producer thread (rounded up to a power of 2), a message may take at most half of it
+    buffer_size:    int,           // formatted bytes collected by the writer before they are written
+    flush_interval: time.Duration, // how long the writer sleeps once the queues are empty
+    full_policy:    Full_Policy,
+}
+
+DEFAULT_ASYNC_OPTIONS :: Async_Options {
+    queue_size     = 1 << 20,
+    buffer_size    = 1 << 16,
+    flush_interval = 2 * time.Millisecond,
+    full_policy    = .Drop,
+};
+
+/**
+ * @brief state of an asynchronous 'Logger': one single producer queue per logging thread, drained by one writer thread
+ */
+Async_Backend :: struct {
+    id:             u64,
+    handle:         os.Handle,
+    config:         Async_Options,
+    queues:         ^Producer_Queue, // lock-free list, a thread pushes its queue with the first message it logs
+    writer:         ^thread.Thread,
+    wake:           sync.Sema,
+    running:        bool,
+    dropped:        u64,
+    flush_requests: u64,
+    flushes:        u64,
+    // owned by the writer thread
+    options:        log.Options,
+    out:            strings.Builder,
+    args:           [dynamic]any,
+    reported:       u64,
+}
+
+/**
+ * @brief byte ring with a single producer (the owning thread moves 'tail') and a single consumer (the writer moves 'head'), both only ever grow
+ */
+@(private="file")
+Producer_Queue :: struct {
+    buffer:    []u8,
+    head:      u64,
+    tail:      u64,
+    thread_id: int,
+    next:      ^Producer_Queue,
+}
+
+/* ENTRIES */
+@(private="file")
+ENTRY_ALIGN :: 16; // every entry (and so the free space at the end of the ring) is a multiple of this, a padding header always fits
+
+@(private="file")
+Entry_Kind :: enum u8 {
+    Padding, // the rest of the ring up to its end is skipped
+    Message, // format string + raw arguments, formatted by the writer
+    Text,    // already formatted text
+}
+
+@(private="file")
+Entry_Header :: struct #align(ENTRY_ALIGN) {
+    size:      u32,
+    kind:      Entry_Kind,
+    arg_count: u16,
+    text_len:  u32,
+    level:     log.Level,
+    time:      i64,
+    location:  runtime.Source_Code_Location,
+}
+
+@(private="file")
+Arg_Slot :: struct {
+    id:     typeid,
+    offset: int, // from the beginning of the entry
+}
+
+@(private="file")
+_align :: #force_inline proc "contextless" (size: int) -> int {
+    return (size + ENTRY_ALIGN - 1) & ~(ENTRY_ALIGN - 1);
+}
+
+/**
+ * @brief arguments copied into the queue as raw bytes: no pointers to memory the caller might release before the writer formats the message
+ * @note strings are copied along with their bytes; structs, slices, maps and the like make the caller format the message itself
+ * @note fmt prints the pointee of a pointer to a struct, union or container (&{...}), such pointers are formatted by the caller too, the same goes for arrays of them
+ */
+@(private="file")
+_is_flat :: proc(info: ^runtime.Type_Info) -> bool {
+    #partial switch v in runtime.type_info_base(info).variant {
+        case runtime.Type_Info_Integer, runtime.Type_Info_Rune, runtime.Type_Info_Float, runtime.Type_Info_Complex, runtime.Type_Info_Quaternion,
+             runtime.Type_Info_Boolean, runtime.Type_Info_Enum, runtime.Type_Info_Bit_Set, runtime.Type_Info_Multi_Pointer,
+             runtime.Type_Info_Type_Id, runtime.Type_Info_Simd_Vector, runtime.Type_Info_Matrix:
+            return true;
+        case runtime.Type_Info_Pointer:
+            if v.elem == nil do return true; // rawptr, only the address is printed
+            #partial switch _ in runtime.type_info_base(v.elem).variant {
+                case runtime.Type_Info_Struct, runtime.Type_Info_Union, runtime.Type_Info_Array, runtime.Type_Info_Enumerated_Array,
+                     runtime.Type_Info_Slice, runtime.Type_Info_Dynamic_Array, runtime.Type_Info_Map:
+                    return false;
+            }
+            return true;
+        case runtime.Type_Info_Array:
+            return _is_flat(v.elem);
+        case runtime.Type_Info_Enumerated_Array:
+            return _is_flat(v.elem);
+    }
+    return false;
+}
+
+@(private="file")
+_is_string :: #force_inline proc(info: ^runtime.Type_Info) -> bool {
+    s, ok := runtime.type_info_base(info).variant.(runtime.Type_Info_String);
+    return ok && !s.is_cstring;
+}
+/*! ENTRIES */
+
+/* PRODUCERS */
+@(private="file")
+_backend_ids: u64;
+
+@(private="file")
+Local_Queue :: struct {
+    backend_id: u64, // ids are never reused, so a stale cache entry of a destroyed logger can never match
+    queue:      ^Producer_Queue,
+}
+
+@(private="file", thread_local)
+_local_queue: Local_Queue;
+
+@(private="file")
+_producer_queue :: proc(backend: ^Async_Backend) -> ^Producer_Queue {
+    if _local_queue.backend_id == backend.id do return _local_queue.queue;
+
+    // the thread may have logged to this logger before another one took the cache (ids of dead threads get reused, and so do their queues)
+    thread_id := os.current_thread_id();
+    for queue := sync.atomic_load_explicit(&backend.queues, .Acquire); queue != nil; queue = queue.next {
+        if queue.thread_id == thread_id {
+            _local_queue = { backend.id, queue };
+            return queue;
+        }
+    }
+
+    queue := new(Producer_Queue, runtime.heap_allocator());
+    queue.buffer    = make([]u8, backend.config.queue_size, runtime.heap_allocator());
+    queue.thread_id = thread_id;
+    for {
+        head := sync.atomic_load_explicit(&backend.queues, .Acquire);
+        queue.next = head;
+        if _, ok := sync.atomic_compare_exchange_weak_explicit(&backend.queues, head, queue, .Release, .Relaxed); ok do break;
+    }
+    _local_queue = { backend.id, queue };
+    return queue;
+}
+
+/**
+ * @brief room for "size" bytes at the tail of the queue of the calling thread; the entry becomes visible with '_queue_publish'
+ */
+@(private="file")
+_queue_reserve :: proc(backend: ^Async_Backend, queue: ^Producer_Queue, size: int) -> (entry: [^]u8, end: u64, ok: bool) {
+    capacity := u64(len(queue.buffer));
+    if u64(size) > capacity / 2 {
+        sync.atomic_add_explicit(&backend.dropped, 1, .Relaxed);
+        return;
+    }
+
+    tail  := queue.tail;
+    index := tail & (capacity - 1);
+    pad   := capacity - index < u64(size) ? capacity - index : 0;
+    woken := false;
+    for tail + pad + u64(size) - sync.atomic_load_explicit(&queue.head, .Acquire) > capacity {
+        if backend.config.full_policy == .Drop {
+            sync.atomic_add_explicit(&backend.dropped, 1, .Relaxed);
+            return;
+        }
+        if !woken {
+            sync.sema_post(&backend.wake);
+            woken = true;
+        }
+        intrinsics.cpu_relax();
+    }
+
+    if pad > 0 {
+        padding := cast(^Entry_Header)&queue.buffer[index];
+        padding.size = u32(pad);
+        padding.kind = .Padding;
+        index = 0;
+    }
+    return raw_data(queue.buffer[index:]), tail + pad + u64(size), true;
+}
+
+@(private="file")
+_queue_publish :: #force_inline proc(queue: ^Producer_Queue, end: u64) {
+    sync.atomic_store_explicit(&queue.tail, end, .Release);
+}
+
+@(private="file")
+_now :: #force_inline proc(options: log.Options) -> i64 {
+    return .Date in options || .Time in options ? time.now()._nsec : 0;
+}
+
+/**
+ * @brief queues the format string and the raw bytes of "args", the writer thread formats them
+ */
+async_push :: proc(backend: ^Async_Backend, level: log.Level, fmt_str: string, args: []any, options: log.Options, location := #caller_location) {
+    size := size_of(Entry_Header) + _align(len(args) * size_of(Arg_Slot) + len(fmt_str));
+    for arg in args {
+        if arg.id == nil do continue;
+        info := type_info_of(arg.id);
+        if _is_string(info) do size += _align(size_of(string) + len((cast(^string)arg.data)^));
+        else if _is_flat(info) do size += _align(info.size);
+        else {
+            async_push_text(backend, level, fmt.tprintf(fmt_str, ..args), options, location);
+            return;
+        }
+    }
+
+    queue := _producer_queue(backend);
+    entry, end, ok := _queue_reserve(backend, queue, size);
+    if !ok do return;
+
+    (cast(^Entry_Header)entry)^ = { u32(size), .Message, u16(len(args)), u32(len(fmt_str)), level, _now(options), location };
+    slots := cast([^]Arg_Slot)entry[size_of(Entry_Header):];
+    mem.copy(entry[size_of(Entry_Header) + len(args) * size_of(Arg_Slot):], raw_data(fmt_str), len(fmt_str));
+
+    offset := size_of(Entry_Header) + _align(len(args) * size_of(Arg_Slot) + len(fmt_str));
+    for arg, i in args {
+        slots[i] = { arg.id, offset };
+        if arg.id == nil do continue;
+        info := type_info_of(arg.id);
+        if _is_string(info) {
+            value := (cast(^string)arg.data)^;
+            bytes := entry[offset + size_of(string):];
+            mem.copy(bytes, raw_data(value), len(value));
+            (cast(^string)entry[offset:])^ = string(bytes[:len(value)]);
+            offset += _align(size_of(string) + len(value));
+        } else {
+            mem.copy(entry[offset:], arg.data, info.size);
+            offset += _align(info.size);
+        }
+    }
+    _queue_publish(queue, end);
+}
+
+/**
+ * @brief queues text that is already formatted
+ */
+async_push_text :: proc(backend: ^Async_Backend, level: log.Level, text: string, options: log.Options, location := #caller_location) {
+    size := size_of(Entry_Header) + _align(len(text));
+    queue := _producer_queue(backend);
+    entry, end, ok := _queue_reserve(backend, queue, size);
+    if !ok do return;
+
+    (cast(^Entry_Header)entry)^ = { u32(size), .Text, 0, u32(len(text)), level, _now(options), location };
+    mem.copy(entry[size_of(Entry_Header):], raw_data(text), len(text));
+    _queue_publish(queue, end);
+}
+
+/**
+ * @brief 'log.Logger_Proc' of an asynchronous 'Logger', so that 'context.logger = logger' (core:log) goes through the queues as well
+ */
+async_logger_proc :: proc(data: rawptr, level: log.Level, text: string, options: log.Options, location := #caller_location) {
+    async_push_text(cast(^Async_Backend)data, level, text, options, location);
+}
+/*! PRODUCERS */
+
+/* WRITER */
+@(private="file")
+_write_entry :: proc(backend: ^Async_Backend, entry: [^]u8) {
+    header := cast(^Entry_Header)entry;
+    out := &backend.out;
+
+    log.do_level_header(backend.options, out, header.level);
+    if header.time != 0 do log.do_time_header(backend.options, out, time.Time{ _nsec = header.time });
+    log.do_location_header(backend.options, out, header.location);
+
+    if header.kind == .Text {
+        strings.write_string(out, string(entry[size_of(Entry_Header):][:header.text_len]));
+    } else {
+        slots := cast([^]Arg_Slot)entry[size_of(Entry_Header):];
+        fmt_str := string(entry[size_of(Entry_Header) + int(header.arg_count) * size_of(Arg_Slot):][:header.text_len]);
+        clear(&backend.args);
+        for slot in slots[:header.arg_count] {
+            append(&backend.args, transmute(any)runtime.Raw_Any{ data = slot.id == nil ? nil : rawptr(entry[slot.offset:]), id = slot.id });
+        }
+        fmt.sbprintf(out, fmt_str, ..backend.args[:]);
+    }
+    strings.write_byte(out, '\n');
+}
+
+@(private="file")
+_write_out :: proc(backend: ^Async_Backend) {
+    if strings.builder_len(backend.out) == 0 do return;
+    os.write(backend.handle, backend.out.buf[:]);
+    strings.builder_reset(&backend.out);
+}
+
+/**
+ * @return number of entries taken out of the queues
+ */
+@(private="file")
+_drain :: proc(backend: ^Async_Backend) -> (drained: int) {
+    for queue := sync.atomic_load_explicit(&backend.queues, .Acquire); queue != nil; queue = queue.next {
+        mask := u64(len(queue.buffer) - 1);
+        head := queue.head;
+        tail := sync.atomic_load_explicit(&queue.tail, .Acquire);
+        for head != tail {
+            entry  := raw_data(queue.buffer[head & mask:]);
+            header := cast(^Entry_Header)entry;
+            if header.kind != .Padding {
+                _write_entry(backend, entry);
+                drained += 1;
+            }
+            head += u64(header.size);
+            // the room goes back to the producer right away, the entry has been formatted
+            sync.atomic_store_explicit(&queue.head, head, .Release);
+            if strings.builder_len(backend.out) >= backend.config.buffer_size do _write_out(backend);
+        }
+    }
+
+    if dropped := sync.atomic_load_explicit(&backend.dropped, .Relaxed); dropped != backend.reported {
+        fmt.sbprintf(&backend.out, "[LOGGER] %v messages dropped, the queue was full\n", dropped - backend.reported);
+        backend.reported = dropped;
+    }
+    return;
+}
+
+@(private="file")
+_writer_loop :: proc(data: rawptr) {
+    backend := cast(^Async_Backend)data;
+    for {
+        // read before draining: whatever was queued before a flush request (or the stop) is in the queues by now
+        requests := sync.atomic_load_explicit(&backend.flush_requests, .Acquire);
+        running  := sync.atomic_load_explicit(&backend.running, .Acquire);
+
+        drained := _drain(backend);
+        if drained == 0 || requests != backend.flushes || !running do _write_out(backend);
+        sync.atomic_store_explicit(&backend.flushes, requests, .Release);
+
+        if !running do break;
+        if drained == 0 do sync.sema_wait_with_timeout(&backend.wake, backend.config.flush_interval);
+    }
+}
+/*! WRITER */
+
+init_async_backend :: proc(handle: os.Handle, options: log.Options, config := DEFAULT_ASYNC_OPTIONS) -> ^Async_Backend {
+    backend := new(Async_Backend, runtime.heap_allocator());
+    backend.id      = sync.atomic_add(&_backend_ids, 1) + 1;
+    backend.handle  = handle;
+    backend.config  = config;
+    backend.config.queue_size = 1 << 12;
+    for backend.config.queue_size < config.queue_size do backend.config.queue_size <<= 1;
+    backend.options = options;
+    backend.out     = strings.builder_make(0, config.buffer_size + 1024, runtime.heap_allocator());
+    backend.args    = make([dynamic]any, runtime.heap_allocator());
+    backend.running = true;
+    backend.writer  = thread.create_and_start_with_data(backend, _writer_loop);
+    return backend;
+}
+
+/**
+ * @brief returns once everything the calling thread queued before the call is written to the file
+ */
+async_flush :: proc(backend: ^Async_Backend) {
+    target := sync.atomic_add_explicit(&backend.flush_requests, 1, .Acq_Rel) + 1;
+    sync.sema_post(&backend.wake);
+    for sync.atomic_load_explicit(&backend.flushes, .Acquire) < target do thread.yield();
+}
+
+/**
+ * @brief stops the writer once it has written every queued message, then closes the file
+ * @note nothing may be logged to "backend" concurrently with (or after) this call
+ */
+destroy_async_backend :: proc(backend: ^Async_Backend) {
+    sync.atomic_store_explicit(&backend.running, false, .Release);
+    sync.sema_post(&backend.wake);
+    thread.join(backend.writer);
+    thread.destroy(backend.writer);
+    os.close(backend.handle);
+
+    queue := backend.queues;
+    for queue != nil {
+        next := queue.next;
+        delete(queue.buffer, runtime.heap_allocator());
+        free(queue, runtime.heap_allocator());
+        queue = next;
+    }
+    strings.builder_destroy(&backend.out);
+    delete(backend.args);
+    free(backend, runtime.heap_allocator());
+}
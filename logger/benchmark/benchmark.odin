@@ -0,0 +1,98 @@
+package main
+
+import "core:fmt"
+import "core:os"
+import "core:slice"
+import "core:sync"
+import "core:thread"
+import "core:time"
+
+import logger "../../logger"
+
+LINES_PER_THREAD :: 100_000;
+SAMPLE_EVERY     :: 16; // every 16th call is timed on its own, timing each call would double the cost being measured
+BENCHMARK_FILE   :: "benchmark.log";
+
+Mode :: enum {
+    Sync,
+    Async_Drop,
+    Async_Block,
+}
+
+Producer :: struct {
+    logger:    ^logger.Logger,
+    latencies: [dynamic]time.Duration,
+}
+
+produce :: proc(data: rawptr) {
+    producer := cast(^Producer)data;
+    for i in 0..<LINES_PER_THREAD {
+        if i % SAMPLE_EVERY != 0 {
+            logger.log_infof(producer.logger.logger, "frame %v took %.3f ms on %s", i, f64(i) * 0.001, "worker");
+            continue;
+        }
+        start := time.tick_now();
+        logger.log_infof(producer.logger.logger, "frame %v took %.3f ms on %s", i, f64(i) * 0.001, "worker");
+        append(&producer.latencies, time.tick_since(start));
+    }
+}
+
+/**
+ * @brief "thread_count" producers logging LINES_PER_THREAD lines each; the time runs until every line reached the file
+ */
+run :: proc(mode: Mode, thread_count: int) {
+    l: logger.Logger;
+    switch mode {
+        case .Sync:        l = logger.init(BENCHMARK_FILE, os.O_CREATE | os.O_TRUNC | os.O_WRONLY);
+        case .Async_Drop:  l = logger.init_async(BENCHMARK_FILE, config = { queue_size = 1 << 20, buffer_size = 1 << 16, flush_interval = 2 * time.Millisecond, full_policy = .Drop, });
+        case .Async_Block: l = logger.init_async(BENCHMARK_FILE, config = { queue_size = 1 << 20, buffer_size = 1 << 16, flush_interval = 2 * time.Millisecond, full_policy = .Block, });
+    }
+
+    producers := make([]Producer, thread_count);
+    threads   := make([]^thread.Thread, thread_count);
+    defer {
+        for &producer in producers do delete(producer.latencies);
+        delete(producers);
+        delete(threads);
+    }
+
+    start := time.tick_now();
+    for &producer, i in producers {
+        producer.logger = &l;
+        threads[i] = thread.create_and_start_with_data(&producer, produce);
+    }
+    for t in threads {
+        thread.join(t);
+        thread.destroy(t);
+    }
+    dropped := l.async != nil ? sync.atomic_load(&l.async.dropped) : 0;
+    logger.dump(&l); // the async writer finishes the queues before the file is closed
+    duration := time.tick_since(start);
+
+    latencies := make([dynamic]time.Duration);
+    defer delete(latencies);
+    for producer in producers do append(&latencies, ..producer.latencies[:]);
+    slice.sort(latencies[:]);
+    total: time.Duration;
+    for latency in latencies do total += latency;
+
+    lines := thread_count * LINES_PER_THREAD - int(dropped);
+    fmt.printf(
+        "\t%-12v %-8v %14.1f %12.1f %12.1f %12v\n",
+        mode, thread_count,
+        f64(lines) / time.duration_seconds(duration),
+        f64(total) / f64(len(latencies)),
+        f64(latencies[(len(latencies) * 99) / 100]),
+        dropped,
+    );
+}
+
+main :: proc() {
+    fmt.printf("Beginning [LOGGER BENCHMARK] %v lines per thread\n", LINES_PER_THREAD);
+    fmt.printf("-----------------------------\n");
+    fmt.printf("\t%-12s %-8s %14s %12s %12s %12s\n", "mode", "threads", "lines/s", "avg [ns]", "p99 [ns]", "dropped");
+    for mode in Mode {
+        for thread_count in ([]int{ 1, 2, 4, 8, 16 }) do run(mode, thread_count);
+    }
+    os.remove(BENCHMARK_FILE);
+}
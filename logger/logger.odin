@@ -7,48 +7,93 @@ import "core:fmt"
 Logger :: struct {
     using logger: log.Logger,
     file_name: string,
+    async: ^Async_Backend, // nil for the synchronous logger
 }
 
 init :: proc(file_name: string = "output.log", write_modes: int = os.O_CREATE | os.O_TRUNC) -> Logger {
     handle, ok := os.open(file_name, write_modes);
     assert(ok == os.ERROR_NONE, "failed to open file!");
-    return Logger{ log.create_file_logger(handle), file_name };
+    return Logger{ logger = log.create_file_logger(handle), file_name = file_name, };
+}
+
+/**
+ * @brief logger whose callers only copy the message into a queue of their thread, a writer thread formats it and writes it in batches (@see async.odin)
+ * @note the arguments are formatted later: strings and plain values are copied, anything else pointing to memory is formatted right away
+ */
+init_async :: proc(file_name: string = "output.log", write_modes: int = os.O_CREATE | os.O_TRUNC, config := DEFAULT_ASYNC_OPTIONS) -> Logger {
+    handle, ok := os.open(file_name, write_modes | os.O_WRONLY, 0o644);
+    assert(ok == os.ERROR_NONE, "failed to open file!");
+    backend := init_async_backend(handle, log.Default_File_Logger_Opts, config);
+    return Logger{
+        logger    = { procedure = async_logger_proc, data = backend, lowest_level = .Debug, options = log.Default_File_Logger_Opts, },
+        file_name = file_name,
+        async     = backend,
+    };
 }
 
 logf :: proc(logger: log.Logger, level: log.Level, fmt_str: string, args: ..any, location := #caller_location) {
+    if level < logger.lowest_level do return;
+    if logger.procedure == async_logger_proc {
+        async_push(cast(^Async_Backend)logger.data, level, fmt_str, args, logger.options, location);
+        return;
+    }
     str := fmt.tprintf(fmt_str, ..args);
     logger.procedure(logger.data, level, str, logger.options, location);    
 }
 
 log_infof :: proc(logger: log.Logger, fmt_str: string, args: ..any, location := #caller_location) {
-    logf(logger, .Info, fmt_str, args, location);
+    logf(logger, .Info, fmt_str, ..args, location = location);
 }
 
 log_debugf :: proc(logger: log.Logger, fmt_str: string, args: ..any, location := #caller_location) {
-    logf(logger, .Debug, fmt_str, args, location);
+    logf(logger, .Debug, fmt_str, ..args, location = location);
 }
 
 log_warnf :: proc(logger: log.Logger, fmt_str: string, args: ..any, location := #caller_location) {
-    logf(logger, .Warning, fmt_str, args, location);
+    logf(logger, .Warning, fmt_str, ..args, location = location);
 }
 
 log_errorf :: proc(logger: log.Logger, fmt_str: string, args: ..any, location := #caller_location) {
-    logf(logger, .Error, fmt_str, args, location);
+    logf(logger, .Error, fmt_str, ..args, location = location);
 }
 
 log_fatalf :: proc(logger: log.Logger, fmt_str: string, args: ..any, location := #caller_location) {
-    logf(logger, .Fatal, fmt_str, args, location);
+    logf(logger, .Fatal, fmt_str, ..args, location = location);
 }
 
 log_customf :: proc(color: string, fmt_str: string, args: ..any, logger := context.logger, location := #caller_location) {
     assert(false, "TO DO!");
 }
 
+/**
+ * @brief truncates the file, an asynchronous logger writes everything queued so far before (and stays asynchronous)
+ */
 clearf :: proc(logger: ^Logger) {
+    if logger.async != nil {
+        config := logger.async.config;
+        dump(logger);
+        logger^ = init_async(logger.file_name, os.O_CREATE | os.O_TRUNC, config);
+        return;
+    }
     dump(logger);
     logger^ = init(logger.file_name, os.O_CREATE | os.O_TRUNC);
 }
 
+/**
+ * @brief waits until an asynchronous logger wrote everything the calling thread logged so far (no-op for the synchronous one)
+ */
+flush :: proc(logger: ^Logger) {
+    if logger.async != nil do async_flush(logger.async);
+}
+
+/**
+ * @note an asynchronous logger writes every queued message before its file is closed
+ */
 dump :: #force_inline proc(logger: ^Logger) {
+    if logger.async != nil {
+        destroy_async_backend(logger.async);
+        logger.async = nil;
+        return;
+    }
     log.destroy_file_logger(logger);
 }
\ No newline at end of file
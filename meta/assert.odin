@@ -11,6 +11,9 @@ AppNotification :: enum {
     CanAbort,
 }
 
+/** @brief number of failed 'massert_ignore' so far, the results of a file whose checks warned are not cached (the next run warns again) */
+meta_warnings: int;
+
 massert_ignore :: #force_inline proc(condition: bool, formatted_string: string, args: ..any) {
     when ODIN_DEBUG do debug_assert_ignore(condition, formatted_string, args);
     else do runtime_assert_ignore(condition, formatted_string, args);
@@ -20,6 +20,7 @@ debug_assert :: proc(notification: AppNotification, condition: bool, formatted_s
     switch notification {
         case .Ignore:
             if !condition {
+                meta_warnings += 1;
                 fmt.print("\x1b[31m[RUNTIME_ASSERTION]:\x1b[0m");
                 fmt.println(fmt.tprintf(formatted_string, args));
                 wait();
@@ -22,6 +22,7 @@ runtime_assert :: proc(notification: AppNotification, condition: bool, formatted
     switch notification {
         case .Ignore:
             if !condition {
+                meta_warnings += 1;
                 fmt.print("\x1b[31m[RUNTIME_ASSERTION]:\x1b[0m");
                 fmt.println(fmt.tprintf(formatted_string, args));
             }
@@ -0,0 +1,156 @@
+//+build windows
+package main
+
+import "core:fmt"
+import "core:os"
+import "core:strings"
+import "core:time"
+
+import meta "../../meta"
+
+PROJECT_DIR        :: "benchmark_project";
+FILES_PER_FOLDER   :: 100;
+TOUCHED_EVERY      :: 100; // ~1% of the files change between the warm runs
+
+files_per_package := [meta.PackageType]int { .DEMO = 1_000, .CORE = 2_000, .EXTERNAL = 1_000 };
+package_prefix    := [meta.PackageType]string { .DEMO = "demo", .CORE = "core", .EXTERNAL = "ext" };
+
+/**
+ * @brief one file of the synthetic project: a tagged struct, internal and external API calls, a core init and a debug only procedure
+ * @note internal API calls are only called from their own file and external ones only from DEMO, so that the run does not warn (a warning would wait for input in debug)
+ */
+write_library_file :: proc(builder: ^strings.Builder, prefix, package_name: string, i: int) {
+    fmt.sbprintf(builder, "package %s\n\nimport \"core:fmt\"\n\n", package_name);
+    fmt.sbprintf(builder, "%s_Config_%d :: struct {\n    id: int \"NexaTag_Marshallable\",\n    name: string \"NexaTag_Marshallable\",\n    weights: []f32,\n}\n\n", prefix, i);
+    fmt.sbprintf(builder, "@(NexaAttr_APICall)\n%s_internal_%d :: proc(x: int) -> int {\n    return x * 2 + %d;\n}\n\n", prefix, i, i);
+    fmt.sbprintf(builder, "@(NexaAttr_APICall=\"external\")\n%s_external_%d :: proc(x: int) -> int {\n    return %s_helper_%d(x) + 1;\n}\n\n", prefix, i, prefix, i);
+    fmt.sbprintf(
+        builder,
+        "%s_helper_%d :: proc(x: int) -> int {\n    total := 0;\n    for j in 0..<x {\n        if j %% 2 == 0 do total += %s_internal_%d(j);\n        else do total -= j;\n    }\n    config := %s_Config_%d{ id = total, name = \"helper\" };\n    fmt.println(config);\n    return total;\n}\n\n",
+        prefix, i, prefix, i, prefix, i,
+    );
+    fmt.sbprintf(builder, "@(NexaAttr_CoreInit)\n%s_init_%d :: proc() -> int {\n    value :: %d;\n    return value;\n}\n\n", prefix, i, i);
+    fmt.sbprintf(builder, "when ODIN_DEBUG {\n\n@(NexaAttr_DebugOnly)\n%s_debug_%d :: proc() {\n    fmt.println(\"%s %d\");\n}\n\n}\n", prefix, i, prefix, i);
+}
+
+write_demo_file :: proc(builder: ^strings.Builder, package_name: string, i: int) {
+    core_files := files_per_package[.CORE];
+    external_files := files_per_package[.EXTERNAL];
+    fmt.sbprintf(builder, "package %s\n\nimport \"core:fmt\"\n\n", package_name);
+    fmt.sbprintf(builder, "Demo_State_%d :: struct {\n    frame: int \"NexaTag_Marshallable\",\n    score: f32,\n}\n\n", i);
+    fmt.sbprintf(builder, "demo_update_%d :: proc(state: ^Demo_State_%d) {\n", i, i);
+    for k in 0..<4 {
+        core := (i * 7 + k * 13) % core_files;
+        external := (i * 11 + k * 3) % external_files;
+        fmt.sbprintf(builder, "    state.frame += core_external_%d(state.frame);\n", core);
+        fmt.sbprintf(builder, "    state.score += f32(ext_external_%d(%d));\n", external, k);
+    }
+    fmt.sbprintf(builder, "    fmt.println(state^);\n}\n");
+}
+
+generate_project :: proc() -> (dirs: [meta.PackageType]string) {
+    os.make_directory(PROJECT_DIR);
+    builder := strings.builder_make();
+    defer strings.builder_destroy(&builder);
+    for kind in meta.PackageType {
+        prefix := package_prefix[kind];
+        dirs[kind] = fmt.aprintf("%s/%s", PROJECT_DIR, prefix);
+        os.make_directory(dirs[kind]);
+        for i in 0..<files_per_package[kind] {
+            folder := fmt.tprintf("%s/%s_mod_%d", dirs[kind], prefix, i / FILES_PER_FOLDER);
+            if i % FILES_PER_FOLDER == 0 do os.make_directory(folder);
+            strings.builder_reset(&builder);
+            package_name := fmt.tprintf("%s_mod_%d", prefix, i / FILES_PER_FOLDER);
+            if kind == .DEMO do write_demo_file(&builder, package_name, i);
+            else do write_library_file(&builder, prefix, package_name, i);
+            assert(os.write_entire_file(fmt.tprintf("%s/%s_%d.odin", folder, prefix, i), builder.buf[:]));
+        }
+        free_all(context.temp_allocator);
+    }
+    return;
+}
+
+/** @brief appends a comment to every TOUCHED_EVERY-th file: same declarations, different hash */
+touch_project :: proc(dirs: [meta.PackageType]string) -> (touched: int) {
+    for kind in meta.PackageType {
+        prefix := package_prefix[kind];
+        for i := 0; i < files_per_package[kind]; i += TOUCHED_EVERY {
+            location := fmt.tprintf("%s/%s_mod_%d/%s_%d.odin", dirs[kind], prefix, i / FILES_PER_FOLDER, prefix, i);
+            src, ok := os.read_entire_file(location);
+            assert(ok);
+            defer delete(src);
+            assert(os.write_entire_file(location, transmute([]u8)fmt.tprintf("%s// touched\n", string(src))));
+            touched += 1;
+        }
+        free_all(context.temp_allocator);
+    }
+    return;
+}
+
+remove_tree :: proc(dir: string) {
+    handle, err := os.open(dir, os.O_RDONLY);
+    if err != os.ERROR_NONE do return;
+    file_infos, _ := os.read_dir(handle, -1);
+    os.close(handle);
+    defer os.file_info_slice_delete(file_infos);
+    for file_info in file_infos {
+        if file_info.is_dir do remove_tree(file_info.fullpath);
+        else do os.remove(file_info.fullpath);
+    }
+    os.remove_directory(dir);
+}
+
+/** @brief 'check_nexa_project' frees the package locations it is given */
+run :: proc(dirs: [meta.PackageType]string, thread_count: int) -> meta.MetaTimings {
+    return meta.check_nexa_project(
+        strings.clone(dirs[.DEMO]),
+        strings.clone(dirs[.CORE]),
+        strings.clone(dirs[.EXTERNAL]),
+        thread_count,
+    );
+}
+
+main :: proc() {
+    remove_tree(PROJECT_DIR);
+    os.remove(meta.META_CACHE_FILENAME);
+    dirs := generate_project();
+    defer {
+        remove_tree(PROJECT_DIR);
+        os.remove(meta.META_CACHE_FILENAME);
+        os.remove(meta.BACKUP_FILENAME);
+        for dir in dirs do delete(dir);
+    }
+
+    Run :: struct {
+        name: string,
+        timings: meta.MetaTimings,
+    }
+    runs: [dynamic]Run;
+    defer delete(runs);
+
+    os.remove(meta.META_CACHE_FILENAME);
+    append(&runs, Run{ "cold, 1 thread", run(dirs, 1) });
+    os.remove(meta.META_CACHE_FILENAME);
+    append(&runs, Run{ "cold", run(dirs, 0) });
+    append(&runs, Run{ "warm", run(dirs, 0) });
+    touched := touch_project(dirs);
+    append(&runs, Run{ "warm, 1% touched", run(dirs, 0) });
+
+    fmt.printf("\nBeginning [META BENCHMARK] synthetic project of %v files, %v touched before the last run\n", runs[0].timings.files, touched);
+    fmt.printf("-----------------------------\n");
+    fmt.printf("\t%-18s %7s %7s %8s %12s %12s %12s %12s %12s\n", "run", "cached", "parsed", "threads", "analyse [ms]", "check [ms]", "resolve [ms]", "cache [ms]", "total [ms]");
+    for r in runs {
+        t := r.timings;
+        fmt.printf(
+            "\t%-18s %7d %7d %8d %12.3f %12.3f %12.3f %12.3f %12.3f\n",
+            r.name, t.cached, t.parsed, t.threads,
+            time.duration_milliseconds(t.analyse), time.duration_milliseconds(t.check), time.duration_milliseconds(t.resolve),
+            time.duration_milliseconds(t.cache_load + t.cache_save), time.duration_milliseconds(t.total),
+        );
+    }
+    fmt.printf(
+        "\twarm run %.1fx faster than the cold one, parallel cold run %.1fx faster than the single threaded one\n",
+        time.duration_milliseconds(runs[1].timings.total) / time.duration_milliseconds(runs[2].timings.total),
+        time.duration_milliseconds(runs[0].timings.total) / time.duration_milliseconds(runs[1].timings.total),
+    );
+}
@@ -0,0 +1,325 @@
+//+build windows
+package meta
+
+import "base:runtime"
+import "core:fmt"
+import "core:hash/xxhash"
+import "core:mem/virtual"
+import "core:os"
+import "core:slice"
+import "core:strings"
+import "core:thread"
+import "core:time"
+
+import "core:odin/parser"
+import "core:odin/ast"
+
+import marshall "nexa_external:binary/marshall"
+
+/*
+* ================================
+*           FileIndex
+* ================================
+*/
+
+/** @brief procedure attribute reduced to what 'collapse_unresolved' needs, so that a cached file does not have to be parsed again */
+IndexedAttribute :: struct {
+    attr_type: CustomProcAttributeType,
+    proc_name: string,
+    resolved: bool,
+}
+/** @brief results of the analysis of one file, persisted in META_CACHE_FILENAME and reused as long as the hash of the file contents does not change */
+FileIndex :: struct {
+    location: string "NexaTag_Marshallable",
+    hash: u64 "NexaTag_Marshallable",
+    attributes: []IndexedAttribute "NexaTag_Marshallable",
+    /** @brief names of all the procedures called in the file (sorted, unique), 'check_proc_usage' looks them up through ProjectContext.usage */
+    calls: []string "NexaTag_Marshallable",
+}
+MetaCache :: []FileIndex;
+META_CACHE_FILENAME :: "meta-cache.bin";
+
+/** @brief declaration the procedure attribute checks run on, found by the same walk that builds the FileIndex */
+AttributeSite :: struct {
+    decl: ^ast.Value_Decl,
+    proc_lit: ^ast.Proc_Lit,
+}
+StructSite :: struct {
+    decl: ^ast.Value_Decl,
+    struct_type: ^ast.Struct_Type,
+}
+
+/**
+ * @brief one file of the project: read, hashed and (unless cached) parsed and indexed on the worker pool, then checked on the main thread
+ * @note everything a parsed file allocates (source, AST, index) lives in its arena, the AST stays alive until 'dump_project' since the attributes point into it
+ */
+AnalysedFile :: struct {
+    pckg: ^PackageContext,
+    /** @brief index into PackageContext.files */
+    file_index: int,
+    index: FileIndex,
+    /** @brief 'index' comes from the cache, the file was neither parsed nor checked */
+    cached: bool,
+    /** @brief the results may be cached: no attribute modified the file and no check warned about it */
+    cacheable: bool,
+    ast_file: ast.File,
+    proc_sites: [dynamic]AttributeSite,
+    struct_sites: [dynamic]StructSite,
+    arena: virtual.Arena,
+    /** @brief set by a worker, reported on the main thread (only the main thread can revert the project) */
+    error: string,
+}
+
+/** @brief timings of one 'check_nexa_project' run */
+MetaTimings :: struct {
+    files, cached, parsed, threads: int,
+    walk, cache_load, analyse, check, resolve, cache_save, total: time.Duration,
+}
+
+print_meta_timings :: proc(using timings: MetaTimings) {
+    fmt.printf("[META TIMINGS]: %d files, %d cached, %d parsed on %d threads\n", files, cached, parsed, threads);
+    fmt.printf("\twalk:       %10.3f ms\n", time.duration_milliseconds(walk));
+    fmt.printf("\tcache load: %10.3f ms\n", time.duration_milliseconds(cache_load));
+    fmt.printf("\tanalyse:    %10.3f ms (read, hash, parse, index)\n", time.duration_milliseconds(analyse));
+    fmt.printf("\tcheck:      %10.3f ms (attribute checks of the parsed files)\n", time.duration_milliseconds(check));
+    fmt.printf("\tresolve:    %10.3f ms\n", time.duration_milliseconds(resolve));
+    fmt.printf("\tcache save: %10.3f ms\n", time.duration_milliseconds(cache_save));
+    fmt.printf("\ttotal:      %10.3f ms\n", time.duration_milliseconds(total));
+}
+
+/**
+ * @brief the single walk over the AST of a file: collects the called procedures and the declarations the attribute and tag checks run on
+ * @note struct tags are not indexed, nothing reads them yet ('check_tags_struct'); a tag check registering CustomStructTag(s) needs the declarations, so it will have to keep such files out of the cache
+ * @note only file scope declarations (including the ones inside 'when' blocks) are sites, the bodies of procedures are walked for calls only
+ */
+index_file :: proc(file: ^AnalysedFile) {
+    VisitorData :: struct {
+        file: ^AnalysedFile,
+        calls: ^[dynamic]string,
+        /** @brief visitor used for the children of a procedure literal (calls only) */
+        nested: ^ast.Visitor,
+        top_level: bool,
+    }
+    _visit :: proc(visitor: ^ast.Visitor, node: ^ast.Node) -> ^ast.Visitor {
+        if visitor == nil || node == nil do return nil;
+        visitor_data := cast(^VisitorData)visitor^.data;
+        #partial switch n in node^.derived {
+            case ^ast.Call_Expr:
+                #partial switch callee in n.expr.derived_expr {
+                    case ^ast.Ident:
+                        append(visitor_data^.calls, callee.name);
+                    case ^ast.Selector_Expr:
+                        if callee.field != nil do append(visitor_data^.calls, callee.field.name);
+                }
+            case ^ast.Proc_Lit:
+                return visitor_data^.nested;
+            case ^ast.Value_Decl:
+                if !visitor_data^.top_level || len(n.values) == 0 do break;
+                #partial switch value in n.values[0].derived_expr {
+                    case ^ast.Proc_Lit:
+                        if len(n.attributes) > 0 do append(&visitor_data^.file^.proc_sites, AttributeSite{ n, value });
+                    case ^ast.Struct_Type:
+                        append(&visitor_data^.file^.struct_sites, StructSite{ n, value });
+                }
+        }
+        return visitor;
+    }
+
+    calls := make([dynamic]string);
+    nested := ast.Visitor{ visit = _visit };
+    nested_data := VisitorData{ file, &calls, &nested, false };
+    nested.data = &nested_data;
+    visitor_data := VisitorData{ file, &calls, &nested, true };
+    visitor := ast.Visitor{ visit = _visit, data = &visitor_data };
+    for decl in file^.ast_file.decls do ast.walk(&visitor, &decl.stmt_base);
+
+    slice.sort(calls[:]);
+    file^.index.calls = slice.unique(calls[:]);
+}
+
+/*
+* ================================
+*        Parallel analysis
+* ================================
+*/
+
+/** @brief files are only parsed on the pool when there are at least this many of them, otherwise on the calling thread */
+META_PARALLEL_MIN_FILES :: 16;
+
+/**
+ * @brief reads and hashes every file of ProjectContext.files on a worker pool; the files that are not in the cache (or changed) are parsed and indexed as well
+ * @note the workers only read the project (the cache map) and write their own AnalysedFile
+ */
+analyse_files :: proc(project: ^ProjectContext) {
+    thread_count := project^.thread_count <= 0 ? os.processor_core_count() : project^.thread_count;
+    thread_count = min(thread_count, len(project^.files));
+    project^.timings.threads = max(thread_count, 1);
+    if thread_count <= 1 || len(project^.files) < META_PARALLEL_MIN_FILES {
+        project^.timings.threads = 1;
+        for _, index in project^.files do _analyse_file(project, index);
+        return;
+    }
+
+    pool: thread.Pool;
+    thread.pool_init(&pool, runtime.heap_allocator(), thread_count);
+    defer thread.pool_destroy(&pool);
+    for _, index in project^.files {
+        thread.pool_add_task(&pool, runtime.heap_allocator(), proc(task: thread.Task) {
+            _analyse_file(cast(^ProjectContext)task.data, task.user_index);
+        }, project, index);
+    }
+    thread.pool_start(&pool);
+    thread.pool_finish(&pool);
+}
+
+@(private="file")
+_analyse_file :: proc(project: ^ProjectContext, index: int) {
+    file := &project^.files[index];
+    location := file^.pckg^.files[file^.file_index].location;
+    file^.index.location = location;
+
+    arena_err := virtual.arena_init_growing(&file^.arena);
+    if arena_err != .None {
+        file^.error = "Failed to create the arena of the file!";
+        return;
+    }
+    context.allocator = virtual.arena_allocator(&file^.arena);
+
+    src, ok := os.read_entire_file(location);
+    if !ok {
+        file^.error = fmt.aprintf("Failed to read file[%s]!", location);
+        return;
+    }
+    file^.index.hash = xxhash.XXH3_64_default(src);
+
+    if cached, found := project^.cache[location]; found && cached^.hash == file^.index.hash {
+        file^.index = cached^;
+        file^.cached = true;
+        virtual.arena_destroy(&file^.arena);
+        return;
+    }
+
+    p := parser.default_parser();
+    file^.ast_file = ast.File{
+        src = string(src),
+        fullpath = location,
+    };
+    if !parser.parse_file(&p, &file^.ast_file) {
+        file^.error = fmt.aprintf("Failed to parse file[%s]! Err count: %d", location, p.error_count);
+        return;
+    }
+    index_file(file);
+}
+
+/**
+ * @brief runs the attribute checks of the parsed files and registers the attributes of the cached ones, in the order the packages were walked
+ * @note main thread only: the checks append to ProjectContext.attributes, may rewrite files and revert the whole project on failure
+ */
+check_analysed_files :: proc(project: ^ProjectContext) {
+    for &file, index in project^.files {
+        massert_cleanup(len(file.error) == 0, "%s\n", file.error);
+        pckg := file.pckg;
+        pckg^.active_file = &pckg^.files[file.file_index];
+        location := pckg^.active_file^.location;
+
+        if file.cached {
+            for attr in file.index.attributes {
+                cached_attribute := append_attribute();
+                cached_attribute^ = CustomProcAttribute {
+                    attr_type = attr.attr_type,
+                    pckg = pckg,
+                    resolved = attr.resolved,
+                    location = location,
+                    proc_name = strings.clone(attr.proc_name),
+                };
+            }
+            project^.timings.cached += 1;
+        } else {
+            first := len(project^.attributes);
+            warnings := meta_warnings;
+            check_file(&file, pckg);
+
+            // everything registered for this file goes into its index
+            file.cacheable = meta_warnings == warnings && len(pckg^.active_file^.src) == 0;
+            attributes := make([]IndexedAttribute, len(project^.attributes) - first, virtual.arena_allocator(&file.arena));
+            for &attr, i in project^.attributes[first:] {
+                attr.proc_name = get_proc_name(&attr, file.ast_file.src);
+                attributes[i] = IndexedAttribute{ attr.attr_type, attr.proc_name, attr.resolved };
+                if attr.attr_type >= .APPLICATION_ENTRY do file.cacheable = false; // rewrites the file on every run
+            }
+            file.index.attributes = attributes;
+            project^.timings.parsed += 1;
+        }
+
+        for name in file.index.calls {
+            _, callers, _, _ := map_entry(&project^.usage, name);
+            append(callers, index);
+        }
+    }
+
+    // the attributes were appended one by one, the entries may point to memory the dynamic array has already left
+    for &attr in project^.attributes {
+        #partial switch attr.attr_type {
+            case .APPLICATION_ENTRY: project^.app_entry = &attr;
+            case .LAUNCHER_ENTRY:    project^.launcher_entry = &attr;
+        }
+    }
+}
+
+/** @brief true if "pckg" is "ancestor" or one of its subpackages */
+package_contains :: proc(ancestor, pckg: ^PackageContext) -> bool {
+    if ancestor == pckg do return true;
+    for &subpackage in ancestor^.subpackages {
+        if package_contains(&subpackage, pckg) do return true;
+    }
+    return false;
+}
+
+dump_analysed_files :: proc(project: ^ProjectContext) {
+    for &file in project^.files {
+        if !file.cached do virtual.arena_destroy(&file.arena);
+    }
+    delete(project^.files);
+    for _, callers in project^.usage do delete(callers);
+    delete(project^.usage);
+
+    for &entry in project^.cache_data {
+        for attr in entry.attributes do dump_string_s(attr.proc_name);
+        for call in entry.calls do dump_string_s(call);
+        dump_string_s(entry.location);
+        delete(entry.attributes);
+        delete(entry.calls);
+    }
+    delete(project^.cache_data);
+    delete(project^.cache);
+}
+
+/*
+* ================================
+*           MetaCache
+* ================================
+*/
+
+/** @brief loads the results of the previous run, a missing or unreadable cache just means that every file is parsed */
+load_meta_cache :: proc(project: ^ProjectContext) {
+    if !os.exists(META_CACHE_FILENAME) do return;
+    cache, err := marshall.marshall_read(MetaCache, META_CACHE_FILENAME);
+    if err != .None {
+        fmt.printf("\x1b[33m[META CACHE]: Failed to load the cache (%v), analysing every file\x1b[0m\n", err);
+        return;
+    }
+    project^.cache_data = cache;
+    for &entry in project^.cache_data do project^.cache[entry.location] = &entry;
+}
+
+/** @brief saves the index of every cacheable file of this run (files that were not found anymore are dropped) */
+save_meta_cache :: proc(project: ^ProjectContext) {
+    entries := make([dynamic]FileIndex, 0, len(project^.files));
+    defer delete(entries);
+    for &file in project^.files {
+        if file.cached || file.cacheable do append(&entries, file.index);
+    }
+    if err := marshall.marshall_write(entries[:], META_CACHE_FILENAME); err != .None {
+        fmt.printf("\x1b[33m[META CACHE]: Failed to save the cache (%v), the next run analyses every file\x1b[0m\n", err);
+    }
+}
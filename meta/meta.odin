@@ -5,6 +5,9 @@ import "core:fmt"
 import "core:strings"
 import "core:os"
 import "core:io"
+import "core:time"
+import "core:slice"
+import "core:mem/virtual"
 
 import "core:odin/parser"
 import "core:odin/ast"
@@ -65,10 +68,12 @@ CustomProcAttribute :: struct {
     resolved: bool,
     /** @brief stores the file location */
     location: string,
+    /** @brief name of the procedure, filled in once the checks of its file are done (cached files have no AST to take it from) */
+    proc_name: string,
 }
 /**
  * @brief procedure to get the name of the function
- * @note this should be only temporary solution (should fix the deletion of ast.src on 'check_file' exit)
+ * @note reads the declaration from the file on disk, for attributes whose AST is not at hand (the analysed files keep theirs alive, see 'check_analysed_files')
  */
 get_proc_name_no_handle :: proc(attr: ^CustomProcAttribute) -> string {
     project := cast(^ProjectContext)context.user_ptr;
@@ -200,11 +205,26 @@ ProjectContext :: struct {
 
     /** @brief formatter used to save data to be formatted for console (useful since not every attribute requires the same info to be printed) */
     formatter: IFormatter,
+
+    /** @brief every file of the project in the order the packages were walked, see 'analyse_files' */
+    files: [dynamic]AnalysedFile,
+    /** @brief procedure name -> indices into 'files' of the files calling it */
+    usage: map[string][dynamic]int,
+    /** @brief results of the previous run (META_CACHE_FILENAME) by file location, points into 'cache_data' */
+    cache: map[string]^FileIndex,
+    cache_data: MetaCache,
+    /** @brief size of the worker pool parsing the files, 0 for one thread per core */
+    thread_count: int,
+    timings: MetaTimings,
 }
 
-init_project :: #force_inline proc(curr_demo_dir, nexa_core_dir, external_dir: string) -> (project: ProjectContext) {
+init_project :: #force_inline proc(curr_demo_dir, nexa_core_dir, external_dir: string, thread_count: int = 0) -> (project: ProjectContext) {
     project.tags = make([dynamic]CustomStructTag);
     project.attributes = make([dynamic]CustomProcAttribute);
+    project.files = make([dynamic]AnalysedFile);
+    project.usage = make(map[string][dynamic]int);
+    project.cache = make(map[string]^FileIndex);
+    project.thread_count = thread_count;
     
     project.packages[.DEMO] = init_package(curr_demo_dir);
     project.packages[.CORE] = init_package(nexa_core_dir);
@@ -218,8 +238,11 @@ init_project :: #force_inline proc(curr_demo_dir, nexa_core_dir, external_dir: s
 dump_project :: #force_inline proc(project: ^ProjectContext) {
     fmt.printf("[DUMP PROJECT]\n");
     defer fmt.printf("\x1b[33m[DUMP PROJECT]: Success\x1b[0m\n");
+    // the analysed files point into the packages
+    dump_analysed_files(project);
     for &pckg in project^.packages do dump_package(&pckg);
     delete(project^.tags);
+    for attr in project^.attributes do dump_string_s(attr.proc_name);
     delete(project^.attributes);
     fmt_proc_dump(&project^.formatter);
 }
@@ -239,20 +262,45 @@ append_tag :: proc(project: ^ProjectContext) -> ^CustomStructTag {
  * @brief checks the whole Nexa project (current Demo + ExternalUtilities/NexaCore)
  * @note this project should be launched implicitly by the NexaCLI and not by the user manually,
  * if no "meta"/precompile is intended to be used, just compile the Demo with odin comp. with ignore-unknown-attributes 
+ * @note files whose contents did not change since the last run are not parsed again, their results come from META_CACHE_FILENAME
  */
-check_nexa_project :: proc(demo_dir, core_dir, external_dir: string) {
-    project := init_project(demo_dir, core_dir, external_dir);
+check_nexa_project :: proc(demo_dir, core_dir, external_dir: string, thread_count: int = 0) -> MetaTimings {
+    project := init_project(demo_dir, core_dir, external_dir, thread_count);
     context.user_ptr = &project;
+    start := time.tick_now();
+    lap := start;
+    _lap :: #force_inline proc(lap: ^time.Tick) -> time.Duration {
+        now := time.tick_now();
+        defer lap^ = now;
+        return time.tick_diff(lap^, now);
+    }
+
+    load_meta_cache(&project);
+    project.timings.cache_load = _lap(&lap);
     fmt.printf("Checking folder [NEXA_CORE]: %s\n", core_dir);
     check_nexa_core(core_dir, &project.packages[.CORE]);
     fmt.printf("Checking folder [EXTERNAL_UTILS]: %s\n", external_dir);
     check_external_utils(external_dir, &project.packages[.EXTERNAL]);
     fmt.printf("Checking folder [DEMO]: %s\n", demo_dir);
     check_demo(demo_dir, &project.packages[.DEMO]);
+    project.timings.files = len(project.files);
+    project.timings.walk = _lap(&lap);
+    // read, hash and parse on the worker pool, then the checks on this thread
+    analyse_files(&project);
+    project.timings.analyse = _lap(&lap);
+    check_analysed_files(&project);
+    project.timings.check = _lap(&lap);
     // some attributes / tags can be only defined once we have parsed everything
     collapse_unresolved();
+    project.timings.resolve = _lap(&lap);
+    save_meta_cache(&project);
+    project.timings.cache_save = _lap(&lap);
+    project.timings.total = time.tick_diff(start, lap);
+    timings := project.timings;
+    print_meta_timings(timings);
     // save the backup
     save_backup();
+    return timings;
 }
 
 check_project_dir :: #force_inline proc(dir: string, pckg: ^PackageContext) {
@@ -277,78 +325,39 @@ read_dir :: proc(dir_name: string) -> []os.File_Info {
 	return file_infos;
 }
 
+/**
+ * @brief walks the package: registers its files and subpackages, every file is queued in ProjectContext.files for 'analyse_files'
+ * @note only ".odin" files are analysed, the others are kept in the package (e.g. for the backup) but never parsed
+ */
 check_folder :: proc(folder_info: os.File_Info, pckg: ^PackageContext) {
 
     massert_cleanup(folder_info.is_dir == true, "Internal meta error: Expected a package/directory; found: %v", folder_info);
 	file_infos := read_dir(folder_info.fullpath);
 	defer os.file_info_slice_delete(file_infos);
-
-    p := parser.default_parser();
-    ast_file: ast.File;
-    handle: os.Handle;
-    err: os.Errno;
-    reader: io.Reader;
-    file_buffer: []u8;
+    project := cast(^ProjectContext)context.user_ptr;
 
     pckg.files = make([]PackageFile, len(file_infos));
+    // the attributes and the analysed files keep pointers to the subpackages, they must not move
+    subpackage_count := 0;
+    for file_info in file_infos do if file_info.is_dir do subpackage_count += 1;
+    reserve(&pckg.subpackages, subpackage_count);
 
     for file_info, index in file_infos {
-        pckg.active_file = &pckg.files[index];
-        pckg.active_file^.location = strings.clone(file_info.fullpath);
+        pckg.files[index].location = strings.clone(file_info.fullpath);
         if file_info.is_dir {
-            append(&pckg.subpackages, init_package(file_info.fullpath));
+            append(&pckg.subpackages, init_package(strings.clone(file_info.fullpath)));
             check_folder(file_info, &pckg.subpackages[len(pckg.subpackages) - 1]);
         }
-        else {
-            handle, err = os.open(file_info.fullpath, os.O_RDONLY);
-            massert_cleanup(err == os.ERROR_NONE, "Failed to read file[%s]! Err: %v\n", file_info.fullpath, err);
-            reader = os.stream_from_handle(handle);
-
-            file_buffer = make([]u8, file_info.size);
-            l, e := io.read_full(reader, file_buffer[:]);
-            os.close(handle);
-            massert_cleanup(l == len(file_buffer) && e == .None, "Failed to read buffer! Error: %v; Lengths: %d :: %d", e, l, len(file_buffer));
-            ast_file = ast.File{
-                src = string(file_buffer),
-                fullpath = pckg.active_file^.location,
-            };
-
-            massert_cleanup(
-                parser.parse_file(&p, &ast_file),
-                "Failed to parse file[%s]! Err count: %d\n",
-                file_info.fullpath, p.error_count,
-            );
-            check_file(&p, &ast_file, pckg);
-            delete(file_buffer); // NOTE: this is wrong, because in some cases we need to be able to access the expressions' tokenizer strings which are only shallow copied from this exact buffer...
+        else if strings.has_suffix(file_info.name, ".odin") {
+            append(&project^.files, AnalysedFile{ pckg = pckg, file_index = index });
         }
     }
 }
 
-check_file :: proc(p: ^parser.Parser, ast_file: ^ast.File, pckg: ^PackageContext) {
-    _internal_iterate_decls :: proc(p: ^parser.Parser, decls: []^ast.Stmt, ast_file: ^ast.File, pckg: ^PackageContext) {
-        for decl in decls {
-            #partial switch d in decl.derived {
-                case ^ast.Value_Decl:
-                    #partial switch expr in d.values[0].derived_expr {
-                        case ^ast.Proc_Lit:
-                            check_attributes_proc(d, expr, ast_file, pckg);
-                        case ^ast.Struct_Type:
-                            check_tags_struct(d, expr, ast_file, pckg);
-                    }
-                case ^ast.When_Stmt:
-                    body_block, ok := d.body.derived_stmt.(^ast.Block_Stmt);
-                    massert_abort(ok, "Internal meta error: This call should always pass...");
-                    _internal_iterate_decls(p, body_block.stmts, ast_file, pckg);
-                    if d.else_stmt != nil {
-                        body_block, ok  = d.else_stmt.derived_stmt.(^ast.Block_Stmt);
-                        massert_abort(ok, "Internal meta error: This call should always pass...");
-                        _internal_iterate_decls(p, body_block.stmts, ast_file, pckg);
-                    }
-            }
-        }
-    }
-
-    _internal_iterate_decls(p, ast_file^.decls[:], ast_file, pckg);
+/** @brief runs the checks on the declarations 'index_file' found in the file (file scope procedures with attributes, structs) */
+check_file :: proc(file: ^AnalysedFile, pckg: ^PackageContext) {
+    for site in file^.proc_sites do check_attributes_proc(site.decl, site.proc_lit, &file^.ast_file, pckg);
+    for site in file^.struct_sites do check_tags_struct(site.decl, site.struct_type, &file^.ast_file, pckg);
 }
 
 check_tags_struct :: proc(d: ^ast.Value_Decl, ast_struct: ^ast.Struct_Type, ast_file: ^ast.File, pckg: ^PackageContext) {
@@ -415,7 +424,6 @@ check_attributes_proc_non_fielded :: proc(
 ) {
     ident, ok := expr.derived.(^ast.Ident);
     if !ok do return;
-    fmt.printf("Ident name: %s\n", ident.name);
     switch ident.name {
         /**
         * @brief automatically assumes "internal" ident, see NexaAttr_APICall fielded
@@ -488,17 +496,15 @@ collapse_unresolved :: proc() {
 /** @brief should check all packages "outisde" the defined package (but also checks whether it is used inside, if yes, should warn) */
 resolve_api_call_external :: proc(attr: ^CustomProcAttribute) {
     project := cast(^ProjectContext)context.user_ptr;
-    proc_name: string = get_proc_name(attr);
-    defer delete_string(proc_name);
+    proc_name := attr^.proc_name;
     for &pckg in project^.packages {
         if attr^.pckg == &pckg { // does not matter that the call is "external", the function does not have to be used at all BUT it cannot be used inside the package
             massert_ignore(
                 !check_proc_usage(
                     &pckg,
                     ProcUsage_Descriptor {
-                        attr^.decl_spec.proc_decl.derived_expr,
-                        attr^.location,
-                        proc_name,
+                        origin_file = attr^.location,
+                        proc_name = proc_name,
                     },
                     false
                 ), 
@@ -513,9 +519,8 @@ resolve_api_call_external :: proc(attr: ^CustomProcAttribute) {
                     !check_proc_usage(
                         &subpackage,
                         ProcUsage_Descriptor {
-                            attr^.decl_spec.proc_decl.derived_expr,
-                            attr^.location,
-                            proc_name,
+                            origin_file = attr^.location,
+                            proc_name = proc_name,
                         },
                         false,
                     ), 
@@ -531,17 +536,15 @@ resolve_api_call_external :: proc(attr: ^CustomProcAttribute) {
 
 resolve_api_call_internal :: proc(attr: ^CustomProcAttribute) {
     project := cast(^ProjectContext)context.user_ptr;
-    proc_name: string = get_proc_name(attr);
-    defer delete_string(proc_name);
+    proc_name := attr^.proc_name;
     for &pckg in project^.packages {
         if attr^.pckg != &pckg { // does not matter that the call is "external", the function does not have to be used at all BUT it cannot be used inside the package
             massert_ignore(
                 !check_proc_usage(
                     &pckg,
                     ProcUsage_Descriptor {
-                        attr^.decl_spec.proc_decl.derived_expr,
-                        attr^.location,
-                        proc_name,
+                        origin_file = attr^.location,
+                        proc_name = proc_name,
                     }, 
                     true,
                 ), 
@@ -554,9 +557,8 @@ resolve_api_call_internal :: proc(attr: ^CustomProcAttribute) {
                     !check_proc_usage(
                         &pckg,
                         ProcUsage_Descriptor {
-                            attr^.decl_spec.proc_decl.derived_expr,
-                            attr^.location,
-                            proc_name,
+                            origin_file = attr^.location,
+                            proc_name = proc_name,
                         }, 
                         true,
                     ), 
@@ -570,71 +572,45 @@ resolve_api_call_internal :: proc(attr: ^CustomProcAttribute) {
 
 /** @brief struct to handle common properties needed for the 'check_proc_usage_folder' proc */
 ProcUsage_Descriptor :: struct {
+    /** @brief declaration of the procedure, nil for attributes of cached files */
     expr: ast.Any_Expr,
     origin_file: string,
     proc_name: string,
 }
-/** @brief checks usage of certain procedure in a package */
+/**
+ * @brief checks usage of certain procedure in a package
+ * @note looks the callers up in ProjectContext.usage (built from the FileIndex of every file) instead of parsing the files of the package again
+ */
 check_proc_usage_folder :: proc(pckg: ^PackageContext, using desc: ProcUsage_Descriptor, $is_internal: bool) -> bool {
-    for file in pckg^.files {
-        if origin_file == file.location && is_internal do continue;
-        if check_proc_usage(file.src, proc_name) do return true;
-    }
-    for &subpackage in pckg^.subpackages {
-        if check_proc_usage_folder(&subpackage, desc, is_internal) do return true;
+    project := cast(^ProjectContext)context.user_ptr;
+    callers, found := project^.usage[proc_name];
+    if !found do return false;
+    for caller in callers {
+        file := &project^.files[caller];
+        if origin_file == file.index.location && is_internal do continue;
+        if package_contains(pckg, file.pckg) do return true;
     }
     return false;
 }
 
 /** @brief checks usage of certain procedure in a file */
-check_proc_usage_file :: #force_inline proc(file_src: string, proc_name: string) -> bool {
-    ast_file := ast.File{
+check_proc_usage_file :: proc(file_src: string, proc_name: string) -> bool {
+    file := AnalysedFile{};
+    arena_err := virtual.arena_init_growing(&file.arena);
+    massert_cleanup(arena_err == .None, "Failed to create the arena! Err: %v\n", arena_err);
+    defer virtual.arena_destroy(&file.arena);
+    context.allocator = virtual.arena_allocator(&file.arena);
+
+    file.ast_file = ast.File{
         src = file_src,
     };
-
     p := parser.default_parser();
-    if parser.parse_file(&p, &ast_file) != true {
+    if parser.parse_file(&p, &file.ast_file) != true {
         massert_cleanup(false, "Failed to parse file!\nErr count: %d\n", p.error_count);
     }
-
-    _visit :: proc(visitor: ^ast.Visitor, node: ^ast.Node) -> ^ast.Visitor {
-        //fmt.printf("%v :: %v\n", visitor, node);
-        if visitor == nil || node == nil do return nil;
-        call_expr, ok := node^.derived.(^ast.Call_Expr);
-        if ok {
-            // check if the call is that of proc_name
-            selector: ^ast.Selector_Expr;
-            ident: ^ast.Ident;
-            selector, ok = call_expr.expr.derived_expr.(^ast.Selector_Expr);
-            if ok do ident = selector.field;
-            else do ident, _ = call_expr.expr.derived_expr.(^ast.Ident);
-
-            visitor_data := cast(^VisitorData)visitor^.data;
-            fmt.println();
-            if ident.name == visitor_data^.proc_name {
-                visitor_data^.found = true;
-                return nil;
-            }
-        }
-        return visitor;
-    }
-    VisitorData :: struct {
-        proc_name: string,
-        found: bool,
-    }
-    visitor_data := VisitorData {
-        proc_name,
-        false,
-    };
-    visitor := ast.Visitor {
-        visit = _visit,
-        data = &visitor_data,
-    };
-    for &decl in ast_file.decls {
-        ast.walk(&visitor, &decl.stmt_base);
-        if visitor_data.found == true do return true;
-    }
-    return false;
+    index_file(&file);
+    _, found := slice.binary_search(file.index.calls, proc_name);
+    return found;
 } 
 
 check_proc_usage :: proc { check_proc_usage_file, check_proc_usage_folder }
@@ -0,0 +1,131 @@
+package main
+
+import "core:fmt"
+import "core:math"
+import "core:math/rand"
+import "core:os"
+import "core:time"
+
+import "../../binary"
+import mixer "../../mixer"
+
+SOURCE_SECONDS   :: 2;
+BENCHMARK_BLOCKS :: 2_000; // ~10.7 s of audio at 48 kHz
+VOICE_COUNTS     :: [?]int { 1, 8, 16, 32, mixer.MIXER_MAX_VOICES };
+TONE_FILE        :: "benchmark_tone.wav";  // stereo 16 bit PCM, mixed by 'mix_samples'
+NOISE_FILE       :: "benchmark_noise.wav"; // mono 32 bit float, mixed by 'mix_mono_to_stereo'
+RENDER_FILE      :: "benchmark_render.wav";
+
+write_sources :: proc() {
+    rate   := int(mixer.DEFAULT_SAMPLE_RATE);
+    frames := SOURCE_SECONDS * rate;
+
+    tone := make([]i16, 2 * frames);
+    defer delete(tone);
+    for i in 0..<frames {
+        t := f32(i) / f32(rate);
+        tone[2 * i]     = i16(math.sin(2 * math.PI * 440 * t) * 16_000);
+        tone[2 * i + 1] = i16(math.sin(2 * math.PI * 660 * t) * 16_000);
+    }
+    noise := make([]f32, frames);
+    defer delete(noise);
+    for &sample in noise do sample = rand.float32_range(-0.25, 0.25);
+
+    assert(mixer.write_wav(TONE_FILE, tone, mixer.SoundChannelTypeStereo, mixer.DEFAULT_SAMPLE_RATE));
+    assert(mixer.write_wav(NOISE_FILE, noise, mixer.SoundChannelTypeMono, mixer.DEFAULT_SAMPLE_RATE));
+}
+
+main :: proc() {
+    write_sources();
+    defer {
+        os.remove(TONE_FILE);
+        os.remove(NOISE_FILE);
+    }
+
+    benchmark_mixing(false);
+    benchmark_mixing(true);
+    benchmark_offline_render();
+}
+
+/**
+ * @brief 'render' into a null sink, on this thread: the wall time of the loop is the CPU time of the mixing
+ * @note "voices/ms" counts voices mixed for one block (MIXER_BLOCK_FRAMES frames) per millisecond of CPU,
+ * "real time voices" is how many voices one core could keep mixing at the sample rate
+ */
+benchmark_mixing :: proc(low_pass: bool) {
+    m := mixer.init(mixer.null_sink());
+    defer mixer.dump(&m);
+    tone, tone_ok   := mixer.load(&m, TONE_FILE);
+    noise, noise_ok := mixer.load(&m, NOISE_FILE);
+    assert(tone_ok && noise_ok);
+    if low_pass {
+        effect := mixer.init_effect();
+        mixer.push_low_pass(&effect, 2_000);
+        mixer.apply_audio_effect(&m.cache[noise], effect);
+    }
+
+    audio_ms := f64(BENCHMARK_BLOCKS * mixer.MIXER_BLOCK_FRAMES) * 1e3 / f64(mixer.DEFAULT_SAMPLE_RATE);
+    fmt.printf("Beginning [MIXER BENCHMARK] %v blocks of %v frames (%.0f ms of audio), half the voices stereo i16, half mono f32%v\n", BENCHMARK_BLOCKS, mixer.MIXER_BLOCK_FRAMES, audio_ms, low_pass ? " + low pass" : "");
+    fmt.printf("-----------------------------\n");
+    fmt.printf("\t%-8s %12s %12s %14s %18s\n", "voices", "time [ms]", "us/block", "voices/ms", "real time voices");
+
+    for count in VOICE_COUNTS {
+        mixer.stop(&m);
+        for i in 0..<count {
+            config := mixer.DEFAULT_PLAYBACK_SOUND_CONFIG;
+            config.blend   = true;
+            config.looping = true;
+            config.volume  = 1 / f32(count);
+            config.start   = (i * 997) % (SOURCE_SECONDS * int(mixer.DEFAULT_SAMPLE_RATE)); // not all voices in phase
+            assert(mixer.play(&m, i % 2 == 0 ? tone : noise, config));
+        }
+        mixer.render(&m, mixer.MIXER_BLOCK_FRAMES); // applies the plays, faults the mapped pages in
+
+        start := time.tick_now();
+        mixer.render(&m, BENCHMARK_BLOCKS * mixer.MIXER_BLOCK_FRAMES);
+        cpu_ms := time.duration_milliseconds(time.tick_since(start));
+        fmt.printf(
+            "\t%-8v %12.3f %12.3f %14.1f %18.0f\n",
+            count, cpu_ms, cpu_ms * 1e3 / BENCHMARK_BLOCKS,
+            f64(count * BENCHMARK_BLOCKS) / cpu_ms,
+            f64(count) * audio_ms / cpu_ms,
+        );
+    }
+    fmt.assertf(mixer.get_dropped_voices(&m) == 0, "\x1b[31m%v plays were dropped\x1b[0m\n", mixer.get_dropped_voices(&m));
+    fmt.printf("\n");
+}
+
+/**
+ * @brief the whole engine on Linux without a device: both sources (the noise one queued after the first tone) rendered into a WAV file, then read back
+ */
+benchmark_offline_render :: proc() {
+    RENDER_SECONDS :: 4;
+    fmt.printf("Beginning [OFFLINE RENDER] %v s into %v\n", RENDER_SECONDS, RENDER_FILE);
+    fmt.printf("-----------------------------\n");
+    defer os.remove(RENDER_FILE);
+
+    sink, ok := mixer.init_wav_sink(RENDER_FILE);
+    assert(ok);
+    m := mixer.init(sink);
+    tone, _  := mixer.load(&m, TONE_FILE);
+    noise, _ := mixer.load(&m, NOISE_FILE);
+    mixer.push_gain(&m.effect, 0.8);
+    mixer.set_volume(&m, 0.9);
+    mixer.play(&m, tone);
+    mixer.enqueue_sound(&m, noise);
+
+    frames := RENDER_SECONDS * int(mixer.DEFAULT_SAMPLE_RATE);
+    start := time.tick_now();
+    assert(mixer.render(&m, frames));
+    state := mixer.get_playback_state(&m);
+    mixer.dump(&m); // closes the sink, which completes the header
+    fmt.printf("\trendered in %.3f ms, state after the last block: %v\n", time.duration_milliseconds(time.tick_since(start)), state);
+
+    reader := binary.init_reader();
+    defer binary.dump_reader(&reader);
+    desc, err := mixer.read_wav(&reader, RENDER_FILE);
+    assert(err == 0);
+    rendered := int(desc.data.subchunk2_size) / (2 * size_of(i16));
+    fmt.assertf(rendered >= frames && rendered < frames + mixer.MIXER_BLOCK_FRAMES, "\x1b[31mrendered %v frames instead of %v\x1b[0m\n", rendered, frames);
+    fmt.printf("\tread back %v frames, %v channels at %v Hz\n\n", rendered, desc.fmt.num_channels, desc.fmt.format_details.pcm.sample_rate);
+}
@@ -1,10 +1,14 @@
 package mixer
 
+import "core:hash"
+
 SoundID :: i32;
 
+/**
+ * @brief FNV-1a of the name, masked to be non negative (negative ids are reserved, @see ALL_SOUNDS)
+ */
 get_id :: proc(sound_name: string) -> SoundID {
-    assert(false, "TO DO!");
-    return 0;
+    return SoundID(hash.fnv32a(transmute([]u8)sound_name) & 0x7fff_ffff);
 }
 
 DEFAULT_SOUND_CACHE_SIZE :: 16;
@@ -14,15 +18,21 @@ init_cache :: #force_inline proc(size: int) -> SoundCache {
     return make_map(SoundCache, size);
 }
 
+/**
+ * @return the cached sound, nil if it was not cached yet and the file could not be loaded
+ */
 load_or_push_sound :: proc(cache: ^SoundCache, sound_name: string) -> ^Sound {
     id := get_id(sound_name);
-    sound, found := &cache[id];
-    if found do return sound;
-    cache[id] = init_sound(sound_name);
-    return &cache[id];
+    if sound, found := &cache[id]; found do return sound;
+    sound := map_insert(cache, id, Sound{});
+    if !init_sound(sound, sound_name) {
+        delete_key(cache, id);
+        return nil;
+    }
+    return sound;
 }
 
 dump_cache :: #force_inline proc(cache: ^SoundCache) {
-    for _, val in cache do dump_sound(&val);
+    for _, &val in cache do dump_sound(&val);
     delete_map(cache^);
-}
\ No newline at end of file
+}
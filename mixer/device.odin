@@ -146,8 +146,6 @@ dump_device_manager :: proc(using device_manager: ^DeviceManager) {
 }
 
 ///////////////
-foreign import libaudio "external/lib/libaudio.lib"
-
 AudioDeviceInfo :: struct {
 	device_name: string,
 	device_description: string,
@@ -164,7 +162,3 @@ AudioDetectError :: enum i32 {
 }
 
 WAVE_MAPPER :: ~u32(0);
-
-foreign libaudio {
-	detect_audio_devices :: proc "cdecl" (num_devices: ^u32, err: ^i32) -> [^]AudioDeviceInfo ---
-}
\ No newline at end of file
@@ -0,0 +1,8 @@
+//+build windows
+package mixer
+
+foreign import libaudio "external/lib/libaudio.lib"
+
+foreign libaudio {
+	detect_audio_devices :: proc "cdecl" (num_devices: ^u32, err: ^i32) -> [^]AudioDeviceInfo ---
+}
@@ -1,12 +1,131 @@
 package mixer
 
-AudioEffect :: struct {}
+import "base:runtime"
+import "core:math"
 
-init_effect :: proc() -> AudioEffect {
-    assert(false, "TO DO!");
-    return {};
+/**
+ * @brief one stage of an effect chain, processes a block of interleaved f32 frames in place
+ */
+Effect_Process :: #type proc(state: rawptr, block: []f32, num_channels: i16, sample_rate: i32);
+
+Effect_Stage :: struct {
+    process: Effect_Process,
+    state:   rawptr,
+    destroy: proc(state: rawptr, allocator: runtime.Allocator), // frees "state" in 'dump_effekt', may be nil
+    clone:   proc(state: rawptr, allocator: runtime.Allocator) -> rawptr, // fresh copy of "state" for a voice ('clone_effect'), nil shares "state"
+}
+
+/**
+ * @brief chain of block effects, applied in the order they were pushed
+ * @note the master chain (Mixer.effect) is not synchronized with the mix thread, build it before 'start_engine'
+ * @note every voice plays the chain of its sound through its own copy ('clone_effect'), so voices never share the state of a stage
+ */
+AudioEffect :: struct {
+    stages: [dynamic]Effect_Stage,
+}
+
+init_effect :: proc(allocator := context.allocator) -> AudioEffect {
+    return { stages = make([dynamic]Effect_Stage, allocator) };
+}
+
+/**
+ * @note a stage without "clone" hands the same "state" to every voice, it then has to be immutable and outlive the voices (it is not destroyed with them)
+ */
+push_effect :: proc(
+    using effect: ^AudioEffect,
+    process: Effect_Process,
+    state: rawptr = nil,
+    destroy: proc(state: rawptr, allocator: runtime.Allocator) = nil,
+    clone: proc(state: rawptr, allocator: runtime.Allocator) -> rawptr = nil,
+) {
+    append(&stages, Effect_Stage{ process, state, destroy, clone });
+}
+
+/**
+ * @brief copy of "effect" owned by one voice, the stage states are cloned into "allocator"
+ * @note the copy is dumped ('dump_effekt') by whoever owns the voice, the mix thread when the voice stops
+ */
+clone_effect :: proc(using effect: ^AudioEffect, allocator := context.allocator) -> AudioEffect {
+    if !has_effect(effect) do return {};
+    copy := AudioEffect{ stages = make([dynamic]Effect_Stage, 0, len(stages), allocator) };
+    for stage in stages {
+        if stage.clone != nil do append(&copy.stages, Effect_Stage{ stage.process, stage.clone(stage.state, allocator), stage.destroy, stage.clone });
+        else do append(&copy.stages, Effect_Stage{ stage.process, stage.state, nil, nil });
+    }
+    return copy;
+}
+
+has_effect :: #force_inline proc "contextless" (using effect: ^AudioEffect) -> bool {
+    return len(stages) > 0;
+}
+
+process_effect :: proc(using effect: ^AudioEffect, block: []f32, num_channels: i16, sample_rate: i32) {
+    for &stage in stages do stage.process(stage.state, block, num_channels, sample_rate);
 }
 
 dump_effekt :: proc(using effect: ^AudioEffect) {
-    assert(false, "TO DO!");
-}
\ No newline at end of file
+    for &stage in stages do if stage.destroy != nil do stage.destroy(stage.state, stages.allocator);
+    delete(stages);
+    stages = nil;
+}
+
+/* BUILT-IN EFFECTS */
+/**
+ * @brief multiplies the block by a constant "gain"
+ */
+push_gain :: proc(effect: ^AudioEffect, gain: f32) {
+    state := new_clone(gain, _state_allocator(effect));
+    push_effect(effect, proc(state: rawptr, block: []f32, num_channels: i16, sample_rate: i32) {
+        scale_samples(block, (cast(^f32)state)^);
+    }, state, _free_state, proc(state: rawptr, allocator: runtime.Allocator) -> rawptr {
+        return new_clone((cast(^f32)state)^, allocator);
+    });
+}
+
+MAX_EFFECT_CHANNELS :: 8;
+
+@(private="file")
+Low_Pass :: struct {
+    cutoff: f32,
+    last:   [MAX_EFFECT_CHANNELS]f32,
+}
+
+/**
+ * @brief one pole low pass filter at "cutoff" Hz, per channel: y += a * (x - y) with a = 1 - e^(-2 pi cutoff / sample_rate)
+ * @note channels above MAX_EFFECT_CHANNELS are left unfiltered
+ */
+push_low_pass :: proc(effect: ^AudioEffect, cutoff: f32) {
+    state := new(Low_Pass, _state_allocator(effect));
+    state.cutoff = cutoff;
+    push_effect(effect, proc(state: rawptr, block: []f32, num_channels: i16, sample_rate: i32) {
+        using filter := cast(^Low_Pass)state;
+        a := 1 - math.exp(-2 * math.PI * cutoff / f32(sample_rate));
+        channels := min(int(num_channels), MAX_EFFECT_CHANNELS);
+        stride := int(num_channels);
+        for c in 0..<channels {
+            y := last[c];
+            #no_bounds_check for i := c; i < len(block); i += stride {
+                y += a * (block[i] - y);
+                block[i] = y;
+            }
+            last[c] = y;
+        }
+    }, state, _free_state, proc(state: rawptr, allocator: runtime.Allocator) -> rawptr {
+        return new_clone(Low_Pass{ cutoff = (cast(^Low_Pass)state).cutoff }, allocator); // a voice starts from silence
+    });
+}
+
+/**
+ * @brief states live in the allocator of the chain, a zero value chain takes the context one like its first append will
+ */
+@(private="file")
+_state_allocator :: proc(using effect: ^AudioEffect) -> runtime.Allocator {
+    if stages.allocator.procedure == nil do stages.allocator = context.allocator;
+    return stages.allocator;
+}
+
+@(private="file")
+_free_state :: proc(state: rawptr, allocator: runtime.Allocator) {
+    free(state, allocator);
+}
+/*! BUILT-IN EFFECTS */
@@ -0,0 +1,325 @@
+package mixer
+
+import "base:intrinsics"
+import "core:simd"
+import "core:slice"
+import "core:sync"
+import "core:thread"
+
+MIXER_BLOCK_FRAMES  :: 256; // frames mixed per block (5.3 ms at 48 kHz)
+MIXER_MAX_VOICES    :: 64;  // voices playing at once, further plays are dropped (@see dropped_voices)
+DEFAULT_SAMPLE_RATE :: i32(48_000);
+MIX_LANES           :: 8;
+
+Sample_Format :: enum u8 {
+    S16, // signed 16 bit, scaled by 1/32768 while mixing
+    F32, // IEEE float, -1..=1
+}
+
+/**
+ * @brief interleaved samples a voice reads from, for sounds loaded from WAV files they point into the mapped file
+ * @note there is no resampling: a source plays at the sample rate of the sink whatever its own "sample_rate" is
+ */
+Voice_Source :: struct {
+    samples:      rawptr,
+    frames:       int,
+    num_channels: i16,
+    format:       Sample_Format,
+    sample_rate:  i32,
+}
+
+/**
+ * @brief everything the mix thread needs to start a voice: a copy of the sound's source (the sound stays in the cache) and a clone of its effect chain
+ * @note the start owns "effect" ('clone_effect' into the heap allocator), the voice it becomes takes it over and dumps it when it stops (@see _stop_voice)
+ */
+Voice_Start :: struct {
+    source: Voice_Source,
+    effect: AudioEffect,
+    sound:  SoundID,
+    config: PlaybackSoundConfig,
+}
+
+@(private="package")
+Voice :: struct {
+    using start: Voice_Start,
+    begin, end, cursor: int, // frames of the source
+    volume: f32,
+    state:  PlaybackState, // .Stopped marks a free slot
+    queued: bool, // the voice is the one of the PlaybackQueue (PlaybackSoundConfig.blend == false)
+}
+
+/**
+ * @brief state of the mixing core, everything but the published counters belongs to the consumer of the command queue
+ * (the mix thread once 'start_engine' ran, the caller of 'render' otherwise)
+ */
+@(private="package")
+Engine :: struct {
+    sink:           Output_Sink,
+    voices:         [MIXER_MAX_VOICES]Voice,
+    commands:       Command_Queue,
+    bus:            []f32, // MIXER_BLOCK_FRAMES interleaved frames of the sink's channels
+    scratch:        []f32, // one voice's frames, for effects and channel layouts the kernels do not handle
+    mix_thread:     ^thread.Thread,
+    running:        bool,
+    paused:         bool,
+    master_volume:  f32,
+    // published after every block
+    state:          i32, // PlaybackState
+    blocks:         u64,
+    dropped_voices: int,
+    sink_failed:    bool,
+}
+
+@(private="package")
+init_engine :: proc(engine: ^Engine, sink: Output_Sink) {
+    assert(sink.write != nil && sink.num_channels > 0 && sink.sample_rate > 0, "invalid output sink!");
+    engine.sink          = sink;
+    engine.bus           = make([]f32, MIXER_BLOCK_FRAMES * int(sink.num_channels));
+    engine.scratch       = make([]f32, MIXER_BLOCK_FRAMES * int(sink.num_channels));
+    engine.master_volume = 1.0;
+    engine.state         = i32(PlaybackState.Stopped);
+}
+
+@(private="package")
+dump_engine :: proc(engine: ^Engine) {
+    if engine.sink.close != nil do engine.sink.close(engine.sink.data);
+    delete(engine.bus);
+    delete(engine.scratch);
+    engine.sink = {};
+    engine.bus, engine.scratch = nil, nil;
+}
+
+/* BLOCK RENDERING */
+/**
+ * @brief applies the pending commands and mixes the next MIXER_BLOCK_FRAMES frames into Engine.bus: every playing voice, then the master chain (Mixer.effect)
+ * @note consumer side of the command queue, called by the mix thread or by 'render'
+ */
+@(private="package")
+render_block :: proc(using mixer: ^Mixer) {
+    drain_commands(mixer);
+    slice.zero(bus);
+
+    if !paused {
+        for &voice in voices do if voice.state == .Playing do _render_voice(mixer, &voice);
+
+        // a queued sound follows the previous one within the same block ('_render_voice'), this starts the queue when it was idle (first play, resume)
+        if !_queue_busy(mixer) && queue.state == .Playing {
+            if next, ok := _queue_pop(&queue); ok do _assign_voice(mixer, next);
+        }
+        if has_effect(&effect) do process_effect(&effect, bus, sink.num_channels, sink.sample_rate);
+    }
+
+    published := PlaybackState.Stopped;
+    if paused do published = .Paused;
+    else {
+        for &voice in voices {
+            if voice.state == .Playing { published = .Playing; break; }
+            if voice.state == .Paused do published = .Paused;
+        }
+    }
+    sync.atomic_store_explicit(&state, i32(published), .Relaxed);
+    sync.atomic_add_explicit(&blocks, 1, .Release);
+}
+
+/**
+ * @brief finds a free voice for "start" and starts it at the beginning of the next block it is rendered in
+ * @return the voice index, -1 (and one more dropped voice) when all MIXER_MAX_VOICES are playing
+ */
+@(private="package")
+_assign_voice :: proc(using mixer: ^Mixer, start: Voice_Start) -> int {
+    start := start;
+    for &voice, i in voices {
+        if voice.state != .Stopped do continue;
+        _start_voice(&voice, start);
+        if voice.queued do queue.current = i;
+        return i;
+    }
+    sync.atomic_add_explicit(&dropped_voices, 1, .Relaxed);
+    _dump_start(&start);
+    return -1;
+}
+
+/**
+ * @brief "voice" (a free slot) takes over "start" and plays from its first frame on
+ */
+@(private="package")
+_start_voice :: proc(voice: ^Voice, start: Voice_Start) {
+    frames := start.source.frames;
+    begin  := clamp(start.config.start, 0, frames);
+    end    := start.config.end < 0 ? frames : clamp(start.config.end, begin, frames);
+    voice^ = {
+        start  = start,
+        begin  = begin,
+        end    = end,
+        cursor = begin,
+        volume = start.config.volume,
+        state  = .Playing,
+        queued = !start.config.blend,
+    };
+}
+
+/**
+ * @brief frees the effect chain a start owns, for starts that never become a voice (dropped, dequeued)
+ */
+@(private="package")
+_dump_start :: #force_inline proc(start: ^Voice_Start) {
+    dump_effekt(&start.effect);
+}
+
+/**
+ * @brief frees the slot of "voice" along with its effect chain, stopping a stopped voice does nothing
+ */
+@(private="package")
+_stop_voice :: proc(voice: ^Voice) {
+    if voice.state == .Stopped do return;
+    voice.state = .Stopped;
+    dump_effekt(&voice.effect);
+}
+
+@(private="file")
+_render_voice :: proc(using mixer: ^Mixer, voice: ^Voice) {
+    channels := int(sink.num_channels);
+    done := 0;
+    for done < MIXER_BLOCK_FRAMES && voice.state == .Playing {
+        gain := voice.volume * master_volume; // per pass, the voice may have been handed the next queued sound
+        frames := min(MIXER_BLOCK_FRAMES - done, voice.end - voice.cursor);
+        if frames > 0 {
+            dst := bus[done * channels:(done + frames) * channels];
+            if has_effect(&voice.effect) {
+                // the chain sees the voice alone, at the sink's layout and unit gain
+                voice_block := scratch[:frames * channels];
+                slice.zero(voice_block);
+                _mix_source(voice_block, &voice.source, voice.cursor, frames, channels, 1);
+                process_effect(&voice.effect, voice_block, sink.num_channels, sink.sample_rate);
+                mix_samples(dst, voice_block, gain);
+            } else {
+                _mix_source(dst, &voice.source, voice.cursor, frames, channels, gain);
+            }
+            voice.cursor += frames;
+            done += frames;
+        }
+        if voice.cursor >= voice.end {
+            if voice.config.looping && voice.end > voice.begin do voice.cursor = voice.begin;
+            else {
+                queued := voice.queued;
+                _stop_voice(voice);
+                // the next queued sound takes over the slot (Mixer.queue.current stays) and goes on from this very frame: the queue plays gapless
+                if queued && queue.state == .Playing {
+                    if next, ok := _queue_pop(&queue); ok do _start_voice(voice, next);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief adds "frames" frames of "source" from frame "cursor" on, times "gain", to the interleaved "dst" of "channels" channels
+ */
+@(private="file")
+_mix_source :: proc(dst: []f32, source: ^Voice_Source, cursor, frames, channels: int, gain: f32) {
+    source_channels := int(source.num_channels);
+    samples := cursor * source_channels;
+    count   := frames * source_channels;
+    switch source.format {
+        case .S16: _mix_layout(dst, ([^]i16)(source.samples)[samples:samples + count], source_channels, channels, gain / 32768);
+        case .F32: _mix_layout(dst, ([^]f32)(source.samples)[samples:samples + count], source_channels, channels, gain);
+    }
+}
+
+@(private="file")
+_mix_layout :: #force_inline proc "contextless" (dst: []f32, src: []$T, src_channels, dst_channels: int, gain: f32) {
+    if src_channels == dst_channels do mix_samples(dst, src, gain);
+    else if src_channels == 1 && dst_channels == 2 do mix_mono_to_stereo(dst, src, gain);
+    else do mix_remap(dst, src, src_channels, dst_channels, gain);
+}
+/*! BLOCK RENDERING */
+
+/* KERNELS */
+@(private="file")
+_splat :: #force_inline proc "contextless" ($V: typeid/#simd[$N]$E, value: E) -> V {
+    lanes: [N]E;
+    for &lane in lanes do lane = value;
+    return transmute(V)lanes;
+}
+
+/**
+ * @brief dst += src * gain, MIX_LANES samples at a time (i16 samples are converted to f32 in the vector, "gain" carries their scale)
+ */
+mix_samples :: proc "contextless" (dst: []f32, src: []$T, gain: f32) where T == i16 || T == f32 {
+    count := min(len(dst), len(src));
+    i := 0;
+    g := _splat(#simd[MIX_LANES]f32, gain);
+    #no_bounds_check for ; i + MIX_LANES <= count; i += MIX_LANES {
+        s := intrinsics.unaligned_load(cast(^#simd[MIX_LANES]T)&src[i]);
+        d := intrinsics.unaligned_load(cast(^#simd[MIX_LANES]f32)&dst[i]);
+        intrinsics.unaligned_store(cast(^#simd[MIX_LANES]f32)&dst[i], d + cast(#simd[MIX_LANES]f32)s * g);
+    }
+    #no_bounds_check for ; i < count; i += 1 do dst[i] += f32(src[i]) * gain;
+}
+
+/**
+ * @brief mono "src" added to both channels of the stereo "dst": every vector of MIX_LANES samples is duplicated into two vectors of frames
+ */
+mix_mono_to_stereo :: proc "contextless" (dst: []f32, src: []$T, gain: f32) where T == i16 || T == f32 {
+    count := min(len(dst) / 2, len(src));
+    i := 0;
+    g := _splat(#simd[MIX_LANES]f32, gain);
+    #no_bounds_check for ; i + MIX_LANES <= count; i += MIX_LANES {
+        s  := cast(#simd[MIX_LANES]f32)intrinsics.unaligned_load(cast(^#simd[MIX_LANES]T)&src[i]) * g;
+        lo := intrinsics.unaligned_load(cast(^#simd[MIX_LANES]f32)&dst[2 * i]);
+        hi := intrinsics.unaligned_load(cast(^#simd[MIX_LANES]f32)&dst[2 * i + MIX_LANES]);
+        intrinsics.unaligned_store(cast(^#simd[MIX_LANES]f32)&dst[2 * i],             lo + swizzle(s, 0, 0, 1, 1, 2, 2, 3, 3));
+        intrinsics.unaligned_store(cast(^#simd[MIX_LANES]f32)&dst[2 * i + MIX_LANES], hi + swizzle(s, 4, 4, 5, 5, 6, 6, 7, 7));
+    }
+    #no_bounds_check for ; i < count; i += 1 {
+        s := f32(src[i]) * gain;
+        dst[2 * i]     += s;
+        dst[2 * i + 1] += s;
+    }
+}
+
+/**
+ * @brief any other channel layout, per frame: more source channels are averaged down (channel c takes c, c + dst_channels, ...), fewer are repeated
+ */
+mix_remap :: proc "contextless" (dst: []f32, src: []$T, src_channels, dst_channels: int, gain: f32) where T == i16 || T == f32 {
+    frames := min(len(dst) / dst_channels, len(src) / src_channels);
+    if src_channels > dst_channels {
+        #no_bounds_check for frame in 0..<frames do for c in 0..<dst_channels {
+            sum, n: f32;
+            for s := c; s < src_channels; s += dst_channels { sum += f32(src[frame * src_channels + s]); n += 1; }
+            dst[frame * dst_channels + c] += sum * gain / n;
+        }
+    } else {
+        #no_bounds_check for frame in 0..<frames do for c in 0..<dst_channels {
+            dst[frame * dst_channels + c] += f32(src[frame * src_channels + c % src_channels]) * gain;
+        }
+    }
+}
+
+/**
+ * @brief samples *= gain in place
+ */
+scale_samples :: proc "contextless" (samples: []f32, gain: f32) {
+    i := 0;
+    g := _splat(#simd[MIX_LANES]f32, gain);
+    #no_bounds_check for ; i + MIX_LANES <= len(samples); i += MIX_LANES {
+        s := intrinsics.unaligned_load(cast(^#simd[MIX_LANES]f32)&samples[i]);
+        intrinsics.unaligned_store(cast(^#simd[MIX_LANES]f32)&samples[i], s * g);
+    }
+    #no_bounds_check for ; i < len(samples); i += 1 do samples[i] *= gain;
+}
+
+/**
+ * @brief f32 samples clipped to -1..=1 and scaled to i16
+ */
+convert_samples_s16 :: proc "contextless" (dst: []i16, src: []f32) {
+    count := min(len(dst), len(src));
+    i := 0;
+    lo, hi, scale := _splat(#simd[MIX_LANES]f32, -1), _splat(#simd[MIX_LANES]f32, 1), _splat(#simd[MIX_LANES]f32, 32767);
+    #no_bounds_check for ; i + MIX_LANES <= count; i += MIX_LANES {
+        s := intrinsics.unaligned_load(cast(^#simd[MIX_LANES]f32)&src[i]);
+        intrinsics.unaligned_store(cast(^#simd[MIX_LANES]i16)&dst[i], cast(#simd[MIX_LANES]i16)(simd.clamp(s, lo, hi) * scale));
+    }
+    #no_bounds_check for ; i < count; i += 1 do dst[i] = i16(clamp(src[i], -1, 1) * 32767);
+}
+/*! KERNELS */
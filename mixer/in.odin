@@ -4,7 +4,7 @@
 
 package mixer
 
-import "../file"
+import "../binary"
 
 WAV_CHUNK_ID :: 0x46464952; // RIFF
 WAV_FORMAT :: 0x45564157; // WAVE
@@ -12,80 +12,78 @@ WAV_SUBCHUNK_1_ID :: 0x20746D66; // fmt
 WAV_SUBCHUNK_2_ID :: 0x61746164; // data
 
 WAV_SUBCHUNK_1_SIZE_PCM :: i32(16);
-
-read_wav :: proc(file_name: string) -> (desc: WAV_DESC, err: i32) {
-	reader := file.Reader{};
-	reader.path = file_name;
-	file.read_from_file(&reader);
+WAV_FORMAT_EXTENSIBLE :: u16(0xFFFE); // the actual format is the first 2 bytes of the sub format GUID
+
+/**
+ * @brief maps "file_name" into "reader" (@see binary.load_mapped) and parses its RIFF chunks, WAV_DESC.data.data points into the mapping
+ * @note chunks other than "fmt " and "data" (LIST, fact, ...) are skipped, a data chunk longer than the file is cut to the file
+ * @return err != 0 when the file cannot be mapped or is not a WAVE file; the mapping stays in "reader" either way (binary.dump_reader)
+ */
+read_wav :: proc(reader: ^binary.Reader, file_name: string) -> (desc: WAV_DESC, err: i32) {
+    if !binary.load_mapped(reader, file_name) do return desc, -1;
+    size := u32(len(reader.buffer));
+    if size < 12 do return desc, -1;
 
     // RIFF CHUNK
     {
-        desc.chunk.chunk_id = file.read_32bits(&reader);
-        when ODIN_DEBUG {
-            assert(desc.chunk.chunk_id == WAV_CHUNK_ID);
-        } else {
-            if desc.chunk.chunk_id != WAV_CHUNK_ID do return desc, -1;
-        }
-    
-        desc.chunk.chunk_size = file.read_32bits(&reader);
-        desc.chunk.format = file.read_32bits(&reader);
-        when ODIN_DEBUG {
-            assert(desc.chunk.format == WAV_FORMAT);
-        } else {
-            if desc.chunk.format != WAV_FORMAT do return desc, -1;
-        }
+        desc.chunk.chunk_id = binary.read_i32(reader);
+        desc.chunk.chunk_size = binary.read_i32(reader);
+        desc.chunk.format = binary.read_i32(reader);
+        if desc.chunk.chunk_id != WAV_CHUNK_ID || desc.chunk.format != WAV_FORMAT do return desc, -1;
     }
 
-    // SUBCHUNK 1
-    {
-        desc.fmt.subchunk1_id = file.read_32bits(&reader);
-        when ODIN_DEBUG {
-            assert(desc.fmt.subchunk1_id == WAV_SUBCHUNK_1_ID);
-        } else {
-            if desc.fmt.subchunk1_id != WAV_SUBCHUNK_1_ID do return desc, -1;
-        }
-
-        desc.fmt.subchunk1_size = file.read_32bits(&reader);
-
-        // format
-        {
-            if desc.fmt.subchunk1_size == WAV_SUBCHUNK_1_SIZE_PCM {
-                desc.fmt.audio_format = cast(AudioFormat)file.read_16bits(&reader);
-
-                desc.fmt.num_channels = file.read_16bits(&reader);
-
-                desc.fmt.format_details.pcm.sample_rate = file.read_32bits(&reader);
+    found_fmt := false;
+    for binary.tell(reader) + 8 <= size {
+        id := binary.read_i32(reader);
+        chunk_size := binary.read_u32(reader);
+        body := binary.tell(reader);
+
+        switch id {
+            // SUBCHUNK 1
+            case WAV_SUBCHUNK_1_ID:
+                if chunk_size < u32(WAV_SUBCHUNK_1_SIZE_PCM) || chunk_size > size - body do return desc, -1;
+                desc.fmt.subchunk1_id = id;
+                desc.fmt.subchunk1_size = i32(chunk_size);
+                format := binary.read_u16(reader);
+                desc.fmt.num_channels = transmute(i16)binary.read_u16(reader);
+                desc.fmt.format_details.pcm.sample_rate = binary.read_i32(reader);
                 // skip byte rate and block align since these can be calculated from the values above.
-                file.skip_bits(&reader, 32 + 16);
-                desc.fmt.format_details.pcm.bits_per_sample = file.read_16bits(&reader);
-            }
-            else {
-                when ODIN_DEBUG do assert(false, "the format subchunk type is not yet supported");
-                else do return desc, -1;
-            }
+                binary.seek(reader, binary.tell(reader) + 4 + 2);
+                desc.fmt.format_details.pcm.bits_per_sample = transmute(i16)binary.read_u16(reader);
+
+                if chunk_size >= 18 {
+                    desc.fmt.param_size = transmute(i16)binary.read_u16(reader);
+                    params := binary.tell(reader);
+                    if desc.fmt.param_size > 0 && u32(desc.fmt.param_size) <= size - params do desc.fmt.params = &reader.buffer[params];
+                    // valid bits (2), channel mask (4), sub format GUID (16)
+                    if format == WAV_FORMAT_EXTENSIBLE && desc.fmt.param_size >= 22 && u32(desc.fmt.param_size) <= size - params {
+                        binary.seek(reader, params + 6);
+                        format = binary.read_u16(reader);
+                    }
+                }
+                desc.fmt.audio_format = cast(AudioFormat)transmute(i16)format;
+                found_fmt = true;
+
+            // SUBCHUNK 2
+            case WAV_SUBCHUNK_2_ID:
+                if !found_fmt do return desc, -1;
+                desc.data.subchunk2_id = id;
+                desc.data.subchunk2_size = i32(min(chunk_size, size - body));
+                desc.data.data = raw_data(reader.buffer[body:]);
+                return desc, 0;
         }
-    }
 
-    // SUNCHUNK 2
-    {
-        desc.data.subchunk2_id = file.read_32bits(&reader);
-        when ODIN_DEBUG {
-            assert(desc.data.subchunk2_id == WAV_SUBCHUNK_2_ID);
-        } else {
-            if desc.data.subchunk2_id != WAV_SUBCHUNK_2_ID do return desc, -1;
-        }
-
-        desc.data.subchunk2_size = file.read_32bits(&reader);
-        desc.data.data = raw_data(reader.data[reader.pos:desc.data.subchunk2_size]);
+        // chunks are word aligned
+        next := u64(body) + u64(chunk_size) + u64(chunk_size & 1);
+        if next > u64(size) do break;
+        binary.seek(reader, u32(next));
     }
-
-    return desc, 0;
+    return desc, -1;
 }
 
 calculate_byte_rate :: proc(format: AudioFormat, sample_rate: i32, num_channels: i16,  bits_per_sample: i16) -> i32 {
     #partial switch (format) {
-        case .PCM_FORMAT:
-        case .IEEE_FLOAT_FORMAT:
+        case .PCM_FORMAT, .IEEE_FLOAT_FORMAT:
             return sample_rate * i32(num_channels * bits_per_sample/8);
     }
     return -1;
@@ -93,9 +91,8 @@ calculate_byte_rate :: proc(format: AudioFormat, sample_rate: i32, num_channels:
 
 calculate_block_align :: proc(format: AudioFormat, num_channels: i16, bits_per_sample: i16) -> i16 {
     #partial switch (format) {
-        case .PCM_FORMAT:
-        case .IEEE_FLOAT_FORMAT:
+        case .PCM_FORMAT, .IEEE_FLOAT_FORMAT:
             return num_channels * bits_per_sample / 8;
     }
     return -1;
-}
\ No newline at end of file
+}
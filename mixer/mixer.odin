@@ -1,21 +1,26 @@
 package mixer
 
+import "base:runtime"
+import "core:sync"
+
 Mixer :: struct {
     cache: SoundCache,
     device: DeviceManager,
     volume: f32,
-    is_playing: bool,
     queue: PlaybackQueue,
-    using _scheduler: Scheduler,
+    effect: AudioEffect, // master chain, runs on every mixed block
+    using _engine: Engine,
 }
 
-// Function to initialize the audio manager
-init :: proc(device_configs: DeviceConfiguraion, num_sounds: int = DEFAULT_SOUND_CACHE_SIZE) -> (mixer: Mixer) {
+/**
+ * @brief the mixer renders into "sink" ('null_sink', 'init_wav_sink', a device backend) on its own thread ('start_engine') or on the caller's ('render')
+ * @note the Mixer must not move once the engine is started, the mix thread keeps a pointer to it
+ */
+init :: proc(sink: Output_Sink, num_sounds: int = DEFAULT_SOUND_CACHE_SIZE) -> (mixer: Mixer) {
     mixer.cache = init_cache(num_sounds);
-    mixer.device = init_device_manager(device_configs);
     mixer.volume = 1.0;
-    mixer.is_playing = false;
     mixer.queue = init_queue();
+    init_engine(&mixer._engine, sink);
     return;
 }
 
@@ -28,48 +33,88 @@ configure_input_device :: proc(mixer: ^Mixer, format: SoundFormat) {
 }
 
 // Function to load a sound to the cache
-load :: proc(using mixer: ^Mixer, filename: string) -> SoundID {
-    assert(false, "TO DO!");
-    return 0;
+load :: proc(using mixer: ^Mixer, filename: string) -> (id: SoundID, ok: bool) {
+    if load_or_push_sound(&cache, filename) == nil do return 0, false;
+    return get_id(filename), true;
 }
 
-// Function to play a sound
-play :: proc(using mixer: ^Mixer, sound_id: SoundID, config: PlaybackSoundConfig = DEFAULT_PLAYBACK_SOUND_CONFIG) {
-    (mixer^).play(mixer, sound_id, config);
-    mixer.is_playing = true;
+/**
+ * @brief starts a voice of "sound_id" with the next block, or queues it behind the playing sound if "config.blend" is false
+ * @note the voice plays its own clone of the sound's effect chain, made here on the caller's thread (@see Voice_Start)
+ * @return false if the sound is not loaded or the command queue is full
+ */
+play :: proc(using mixer: ^Mixer, sound_id: SoundID, config: PlaybackSoundConfig = DEFAULT_PLAYBACK_SOUND_CONFIG) -> bool {
+    sound, found := &cache[sound_id];
+    if !found do return false;
+    start := Voice_Start{ sound.source, clone_effect(&sound.audio_effect, runtime.heap_allocator()), sound_id, config };
+    if !push_command(mixer, { kind = .Play, sound = sound_id, start = start }) {
+        _dump_start(&start);
+        return false;
+    }
+    return true;
 }
 
-@(private="package")
-_play :: proc(using mixer: ^Mixer, sound_id: ^SoundID, config: ^PlaybackSoundConfig) {
-    // enqueue the sound
-    enqueue_sound(mixer, sound_id^);
+// Function to pause a sound
+pause :: proc(using mixer: ^Mixer, sound_id: SoundID = ALL_SOUNDS) -> bool {
+    return push_command(mixer, { kind = .Pause, sound = sound_id });
 }
 
-// Function to pause a sound
-pause :: proc(using mixer: ^Mixer, sound_id: SoundID) {
-    mixer.is_playing = false;
+resume :: proc(using mixer: ^Mixer, sound_id: SoundID = ALL_SOUNDS) -> bool {
+    return push_command(mixer, { kind = .Resume, sound = sound_id });
 }
 
-// Function to stop a sound
-stop :: proc(using mixer: ^Mixer, sound_id: SoundID) {
-    mixer.is_playing = false;
+/**
+ * @brief stops every voice of "sound_id" and drops its queued plays
+ */
+stop :: proc(using mixer: ^Mixer, sound_id: SoundID = ALL_SOUNDS) -> bool {
+    return push_command(mixer, { kind = .Stop, sound = sound_id });
 }
 
-set_volume :: #force_inline proc(using mixer: ^Mixer, new_volume: f32) {
+set_volume :: #force_inline proc(using mixer: ^Mixer, new_volume: f32) -> bool {
     volume = new_volume;
+    return push_command(mixer, { kind = .Volume, sound = ALL_SOUNDS, volume = new_volume });
 }
 
-get_playback_state :: proc(mixer: ^Mixer) -> PlaybackState {
-    assert(false, "TO DO!");
-    return PlaybackState.Paused;
+/**
+ * @brief volume of the voices of "sound_id" playing now, later plays start with PlaybackSoundConfig.volume
+ */
+set_sound_volume :: #force_inline proc(using mixer: ^Mixer, sound_id: SoundID, new_volume: f32) -> bool {
+    return push_command(mixer, { kind = .Volume, sound = sound_id, volume = new_volume });
 }
 
-// Function to unload a sound from the cache
-unload :: proc(using mixer: ^Mixer, sound_id: SoundID) {}
+/**
+ * @brief state after the last mixed block: .Playing if any voice played, .Paused if the mixer or all remaining voices are paused
+ */
+get_playback_state :: proc(using mixer: ^Mixer) -> PlaybackState {
+    return PlaybackState(sync.atomic_load_explicit(&state, .Relaxed));
+}
+
+/**
+ * @brief plays dropped so far because all MIXER_MAX_VOICES voices (or the PLAYBACK_QUEUE_CAPACITY queue) were busy
+ */
+get_dropped_voices :: proc(using mixer: ^Mixer) -> int {
+    return sync.atomic_load_explicit(&dropped_voices, .Relaxed);
+}
+
+/**
+ * @note waits for the mix thread to stop the voices of the sound before unmapping it
+ */
+unload :: proc(using mixer: ^Mixer, sound_id: SoundID) {
+    if sound_id not_in cache do return;
+    for !push_command(mixer, { kind = .Stop, sound = sound_id }) do sync_commands(mixer);
+    sync_commands(mixer);
+    dump_sound(&cache[sound_id]);
+    delete_key(&cache, sound_id);
+}
 
 // Function to clean up the audio manager
-dump :: #force_inline proc(using mixer: ^Mixer) {
+dump :: proc(using mixer: ^Mixer) {
+    stop_engine(mixer);
+    // the effect chains of the plays still in the command queue and of the voices still playing
+    drain_commands(mixer);
+    for &voice in voices do _stop_voice(&voice);
     dump_cache(&mixer.cache);
-    dump_device_manager(&mixer.device);
     dump_queue(&mixer.queue);
-}
\ No newline at end of file
+    dump_effekt(&mixer.effect);
+    dump_engine(&mixer._engine);
+}
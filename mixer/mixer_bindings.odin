@@ -1,3 +1,4 @@
+//+build windows
 package mixer
 
 foreign import "external/lib/libaudio.lib" {
@@ -1,2 +1,48 @@
+/*
+    THIS FILE CONTAINS THE "OUT"PUT HANDLING OF SOUNDS (WRITING .wav etc.)
+*/
+
 package mixer
 
+import "core:encoding/endian"
+import "core:os"
+
+WAV_HEADER_SIZE :: 44;
+
+/**
+ * @brief canonical 44 byte header (RIFF, "fmt " with 16 bytes, "data") of "frames" frames, the layout 'read_wav' accepts
+ */
+wav_header :: proc(format: AudioFormat, num_channels: i16, sample_rate: i32, bits_per_sample: i16, frames: int) -> (header: [WAV_HEADER_SIZE]u8) {
+    data_size := u32(frames) * u32(calculate_block_align(format, num_channels, bits_per_sample));
+    b := header[:];
+    endian.put_u32(b[0:],  .Little, WAV_CHUNK_ID);
+    endian.put_u32(b[4:],  .Little, WAV_HEADER_SIZE - 8 + data_size);
+    endian.put_u32(b[8:],  .Little, WAV_FORMAT);
+    endian.put_u32(b[12:], .Little, WAV_SUBCHUNK_1_ID);
+    endian.put_u32(b[16:], .Little, u32(WAV_SUBCHUNK_1_SIZE_PCM));
+    endian.put_u16(b[20:], .Little, u16(format));
+    endian.put_u16(b[22:], .Little, u16(num_channels));
+    endian.put_u32(b[24:], .Little, u32(sample_rate));
+    endian.put_u32(b[28:], .Little, u32(calculate_byte_rate(format, sample_rate, num_channels, bits_per_sample)));
+    endian.put_u16(b[32:], .Little, u16(calculate_block_align(format, num_channels, bits_per_sample)));
+    endian.put_u16(b[34:], .Little, u16(bits_per_sample));
+    endian.put_u32(b[36:], .Little, WAV_SUBCHUNK_2_ID);
+    endian.put_u32(b[40:], .Little, data_size);
+    return;
+}
+
+/**
+ * @brief writes interleaved "samples" as a 16 bit PCM (i16) or 32 bit IEEE float (f32) WAV file
+ * @note the samples are written as they are in memory, i.e. little endian hosts only
+ */
+write_wav :: proc(file_name: string, samples: []$T, num_channels: i16, sample_rate: i32) -> bool where T == i16 || T == f32 {
+    format := AudioFormat.PCM_FORMAT when T == i16 else AudioFormat.IEEE_FLOAT_FORMAT;
+    handle, err := os.open(file_name, os.O_WRONLY | os.O_CREATE | os.O_TRUNC, 0o644);
+    if err != os.ERROR_NONE do return false;
+    defer os.close(handle);
+
+    header := wav_header(format, num_channels, sample_rate, size_of(T) * 8, len(samples) / int(num_channels));
+    if _, err = os.write(handle, header[:]); err != os.ERROR_NONE do return false;
+    _, err = os.write(handle, ([^]u8)(raw_data(samples))[:len(samples) * size_of(T)]);
+    return err == os.ERROR_NONE;
+}
@@ -7,44 +7,107 @@ PlaybackState :: enum {
 }
 
 PlaybackSoundConfig :: struct {
-    start: int,
-    end: int,
-    blend: bool, // whether it should start immediately even if other sound is playing 
+    start: int, // first frame
+    end: int, // one past the last frame
+    blend: bool, // whether it should start immediately even if other sound is playing
+    looping: bool, // restarts at "start" once "end" is reached, until stopped
+    volume: f32,
 }
 
 DEFAULT_PLAYBACK_SOUND_CONFIG :: PlaybackSoundConfig {
     start = 0, // start from the beginning
     end = -1, // -1 for the end of the track
     blend = false,
+    looping = false,
+    volume = 1.0,
 }
 
-PlaybackQueue :: struct {
+PLAYBACK_QUEUE_CAPACITY :: 32;
 
+/**
+ * @brief sounds played without "blend" play one after another: one of them owns a voice ("current"), the rest wait here in order
+ * @note owned by the consumer of the command queue (mix thread), the API reaches it through commands only
+ */
+PlaybackQueue :: struct {
+    pending: [PLAYBACK_QUEUE_CAPACITY]Voice_Start,
+    first:   int,
+    count:   int,
+    current: int, // voice of the sound playing now, -1 when none
+    state:   PlaybackState,
 }
 
 init_queue :: proc() -> PlaybackQueue {
-    assert(false, "TO DO!");
-    return {};
+    return { current = -1, state = .Playing };
 }
 
-change_queue_state :: proc(using queue: ^PlaybackQueue, state: PlaybackState) {
-    assert(false, "TO DO!");
+/**
+ * @brief .Paused keeps the next sound from starting, .Stopped also forgets every pending one
+ */
+change_queue_state :: proc(queue: ^PlaybackQueue, state: PlaybackState) {
+    queue.state = state;
     switch(state) {
         case .Paused:
         case .Playing:
         case .Stopped:
-            break;
+            for i in 0..<queue.count do _dump_start(&queue.pending[(queue.first + i) % PLAYBACK_QUEUE_CAPACITY]);
+            queue.first, queue.count = 0, 0;
     }
 }
 
-enqueue_sound :: proc(mixer: ^Mixer, sound_id: SoundID) {
-    assert(false, "TO DO!");
+/**
+ * @brief plays "sound_id" once the sounds queued before it have finished
+ */
+enqueue_sound :: proc(mixer: ^Mixer, sound_id: SoundID, config: PlaybackSoundConfig = DEFAULT_PLAYBACK_SOUND_CONFIG) -> bool {
+    config := config;
+    config.blend = false;
+    return play(mixer, sound_id, config);
 }
 
+/**
+ * @brief removes the pending plays of "sound_id" from the queue, the one already playing keeps playing ('stop')
+ */
 dequeue_sound :: proc(mixer: ^Mixer, sound_id: SoundID) {
-    assert(false, "TO DO!");
+    push_command(mixer, { kind = .Dequeue, sound = sound_id });
 }
 
 dump_queue :: proc(using queue: ^PlaybackQueue) {
-    assert(false, "TO DO!");
-}
\ No newline at end of file
+    change_queue_state(queue, .Stopped);
+    queue^ = init_queue();
+}
+
+@(private="package")
+_queue_busy :: #force_inline proc(using mixer: ^Mixer) -> bool {
+    return queue.current >= 0 && voices[queue.current].queued && voices[queue.current].state != .Stopped;
+}
+
+@(private="package")
+_queue_push :: proc(using queue: ^PlaybackQueue, start: Voice_Start) -> bool {
+    if count == PLAYBACK_QUEUE_CAPACITY do return false;
+    pending[(first + count) % PLAYBACK_QUEUE_CAPACITY] = start;
+    count += 1;
+    return true;
+}
+
+@(private="package")
+_queue_pop :: proc(using queue: ^PlaybackQueue) -> (start: Voice_Start, ok: bool) {
+    if count == 0 do return {}, false;
+    start = pending[first];
+    first = (first + 1) % PLAYBACK_QUEUE_CAPACITY;
+    count -= 1;
+    return start, true;
+}
+
+@(private="package")
+_queue_remove :: proc(using queue: ^PlaybackQueue, sound_id: SoundID) {
+    kept := 0;
+    for i in 0..<count {
+        start := pending[(first + i) % PLAYBACK_QUEUE_CAPACITY];
+        if start.sound == sound_id {
+            _dump_start(&start);
+            continue;
+        }
+        pending[(first + kept) % PLAYBACK_QUEUE_CAPACITY] = start;
+        kept += 1;
+    }
+    count = kept;
+}
@@ -0,0 +1,106 @@
+package mixer
+
+import "core:os"
+import "core:slice"
+
+/**
+ * @brief writes one mixed block: MIXER_BLOCK_FRAMES interleaved f32 frames, nominally -1..=1 but not clipped
+ * @return false stops the mix thread (Mixer.sink_failed)
+ */
+Sink_Write :: #type proc(data: rawptr, block: []f32, num_channels: i16) -> bool;
+Sink_Close :: #type proc(data: rawptr);
+
+/**
+ * @brief where the mix thread ('start_engine') or 'render' sends the mixed blocks, device backends plug in here
+ */
+Output_Sink :: struct {
+    data:         rawptr,
+    write:        Sink_Write,
+    close:        Sink_Close, // called by 'dump', may be nil
+    sample_rate:  i32,
+    num_channels: i16,
+    blocking:     bool, // 'write' waits for the device, otherwise the mix thread sleeps between blocks to keep real time
+}
+
+/**
+ * @brief discards every block: a mixer without an audio device, or for measuring the mixing alone
+ */
+null_sink :: proc(sample_rate := DEFAULT_SAMPLE_RATE, num_channels := SoundChannelTypeStereo) -> Output_Sink {
+    return {
+        write        = proc(data: rawptr, block: []f32, num_channels: i16) -> bool { return true; },
+        sample_rate  = sample_rate,
+        num_channels = num_channels,
+    };
+}
+
+@(private="file")
+Wav_Sink :: struct {
+    handle:       os.Handle,
+    format:       AudioFormat,
+    sample_rate:  i32,
+    num_channels: i16,
+    frames:       int,
+    samples:      []i16, // one block converted to PCM
+}
+
+/**
+ * @brief writes the blocks to a 16 bit PCM (or 32 bit IEEE float) WAV file, the sizes in the header are filled in when the sink is closed ('dump')
+ * @note with 'render' it renders offline as fast as the mixing goes, with 'start_engine' it records in real time
+ */
+init_wav_sink :: proc(
+    file_name: string,
+    sample_rate := DEFAULT_SAMPLE_RATE,
+    num_channels := SoundChannelTypeStereo,
+    format := AudioFormat.PCM_FORMAT,
+) -> (sink: Output_Sink, ok: bool) {
+    assert(format == .PCM_FORMAT || format == .IEEE_FLOAT_FORMAT, "the wav sink writes 16 bit PCM or 32 bit float!");
+    handle, err := os.open(file_name, os.O_WRONLY | os.O_CREATE | os.O_TRUNC, 0o644);
+    if err != os.ERROR_NONE do return {}, false;
+
+    header := wav_header(format, num_channels, sample_rate, _wav_sink_bits(format), 0);
+    if _, err = os.write(handle, header[:]); err != os.ERROR_NONE {
+        os.close(handle);
+        return {}, false;
+    }
+
+    state := new(Wav_Sink);
+    state^ = { handle = handle, format = format, sample_rate = sample_rate, num_channels = num_channels };
+    if format == .PCM_FORMAT do state.samples = make([]i16, MIXER_BLOCK_FRAMES * int(num_channels));
+    return {
+        data         = state,
+        write        = _wav_sink_write,
+        close        = _wav_sink_close,
+        sample_rate  = sample_rate,
+        num_channels = num_channels,
+    }, true;
+}
+
+@(private="file")
+_wav_sink_bits :: #force_inline proc "contextless" (format: AudioFormat) -> i16 {
+    return format == .PCM_FORMAT ? 16 : 32;
+}
+
+@(private="file")
+_wav_sink_write :: proc(data: rawptr, block: []f32, channels: i16) -> bool {
+    using sink := cast(^Wav_Sink)data;
+    bytes := slice.to_bytes(block);
+    if format == .PCM_FORMAT {
+        pcm := samples[:min(len(block), len(samples))];
+        convert_samples_s16(pcm, block);
+        bytes = slice.to_bytes(pcm);
+    }
+    _, err := os.write(handle, bytes);
+    frames += len(block) / int(channels);
+    return err == os.ERROR_NONE;
+}
+
+@(private="file")
+_wav_sink_close :: proc(data: rawptr) {
+    using sink := cast(^Wav_Sink)data;
+    header := wav_header(format, num_channels, sample_rate, _wav_sink_bits(format), frames);
+    os.seek(handle, 0, os.SEEK_SET);
+    os.write(handle, header[:]);
+    os.close(handle);
+    delete(samples);
+    free(sink);
+}
@@ -1,5 +1,7 @@
 package mixer
 
+import "../binary"
+
 Sound :: struct #no_copy {
     format_type: AudioFormatType,
     using data: struct #raw_union {
@@ -7,17 +9,57 @@ Sound :: struct #no_copy {
         wav: WAV_DESC,
     },
     audio_effect: AudioEffect,
+    source: Voice_Source, // the samples voices of the sound read
+    reader: binary.Reader, // keeps the file mapped
 }
 
-init_sound :: proc(sound_name: string) -> Sound {
-    assert(false, "TO DO!");
-    return {};
+/**
+ * @brief maps the WAV file "sound_name" and describes its data chunk as a Voice_Source
+ * @note 16 bit PCM and 32 bit IEEE float samples are supported
+ * @return false for any other file, "sound" holds nothing to dump then
+ */
+init_sound :: proc(sound: ^Sound, sound_name: string) -> bool {
+    wav, err := read_wav(&sound.reader, sound_name);
+    bits := wav.fmt.format_details.pcm.bits_per_sample;
+    format: Sample_Format;
+    switch {
+        case err != 0 || wav.fmt.num_channels <= 0:
+            err = -1;
+        case wav.fmt.audio_format == .PCM_FORMAT && bits == 16:
+            format = .S16;
+        case wav.fmt.audio_format == .IEEE_FLOAT_FORMAT && bits == 32:
+            format = .F32;
+        case:
+            err = -1;
+    }
+    if err != 0 {
+        binary.dump_reader(&sound.reader);
+        return false;
+    }
+
+    sound.format_type = .WAV;
+    sound.wav = wav;
+    sound.source = {
+        samples      = wav.data.data,
+        frames       = int(wav.data.subchunk2_size) / (int(wav.fmt.num_channels) * int(bits / 8)),
+        num_channels = wav.fmt.num_channels,
+        format       = format,
+        sample_rate  = wav.fmt.format_details.pcm.sample_rate,
+    };
+    return true;
 }
 
+/**
+ * @brief "sound" takes over "effect" (built with 'init_effect', 'push_effect', ...), the previous chain is dumped
+ * @note the voices playing "sound" keep their own clone of the chain they started with, later plays pick up "effect"
+ */
 apply_audio_effect :: proc(sound: ^Sound, effect: AudioEffect) {
-    assert(false, "TO DO!");
+    dump_effekt(&sound.audio_effect);
+    sound.audio_effect = effect;
 }
 
 dump_sound :: proc(sound: ^Sound) {
-    assert(false, "TO DO!");
-}
\ No newline at end of file
+    binary.dump_reader(&sound.reader);
+    dump_effekt(&sound.audio_effect);
+    sound.source = {};
+}
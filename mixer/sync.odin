@@ -1,49 +1,171 @@
 package mixer
 
-import tr "core:thread"
+import "core:sync"
+import "core:thread"
+import "core:time"
+
+COMMAND_QUEUE_CAPACITY :: 256; // must be a power of 2
+#assert(COMMAND_QUEUE_CAPACITY & (COMMAND_QUEUE_CAPACITY - 1) == 0);
+
+ALL_SOUNDS :: SoundID(-1); // 'get_id' never returns a negative id
+
+@(private="package")
+Command_Kind :: enum u8 {
+    Play,
+    Pause,
+    Resume,
+    Stop,
+    Dequeue,
+    Volume,
+}
 
 @(private="package")
-Scheduler :: struct {
-	thread: ^tr.Thread,
-	play:   #type proc(
-		using mixer: ^Mixer,
-		sound_id: SoundID,
-		config: PlaybackSoundConfig = DEFAULT_PLAYBACK_SOUND_CONFIG,
-	),
+Command :: struct {
+    kind:   Command_Kind,
+    sound:  SoundID, // ALL_SOUNDS: every voice (Pause/Resume/Stop), the master volume (Volume)
+    volume: f32,
+    start:  Voice_Start,
 }
 
+/**
+ * @brief single producer single consumer ring, "head" (commands applied) and "tail" (commands published) only grow
+ * @note the API threads serialize on "producer" to act as the single producer, the consumer (mix thread) never locks nor waits
+ */
 @(private="package")
-init_scheduler :: proc() -> (s: Scheduler) {
-	s.play = scheduler_play;
-	return;
+Command_Queue :: struct {
+    commands: [COMMAND_QUEUE_CAPACITY]Command,
+    head:     u64,
+    tail:     u64,
+    producer: sync.Mutex,
 }
 
+/**
+ * @return false if the queue is full (the mix thread is stalled, or 'render' has not been called for COMMAND_QUEUE_CAPACITY commands)
+ */
 @(private="package")
-scheduler_play :: proc(
-	mixer: ^Mixer,
-	sound_id: SoundID,
-	config: PlaybackSoundConfig = DEFAULT_PLAYBACK_SOUND_CONFIG,
-) {
-    sound_id := sound_id;
-    config   := config;
-    mixer^.thread = tr.create(_scheduler_play);
-	mixer^.thread^.user_args[0] = auto_cast mixer;
-	mixer^.thread^.user_args[1] = auto_cast &sound_id;
-	mixer^.thread^.user_args[2] = auto_cast &config;
-	tr.start(mixer^.thread);
+push_command :: proc(using mixer: ^Mixer, command: Command) -> bool {
+    sync.mutex_guard(&commands.producer);
+    tail := sync.atomic_load_explicit(&commands.tail, .Relaxed);
+    if tail - sync.atomic_load_explicit(&commands.head, .Acquire) == COMMAND_QUEUE_CAPACITY do return false;
+    commands.commands[tail & (COMMAND_QUEUE_CAPACITY - 1)] = command;
+    sync.atomic_store_explicit(&commands.tail, tail + 1, .Release);
+    return true;
 }
 
 @(private="package")
-_scheduler_play :: proc(using thread: ^tr.Thread) {
-	_play(
-		cast(^Mixer)user_args[0],
-		(cast(^SoundID)user_args[1]),
-		(cast(^PlaybackSoundConfig)user_args[2]),
-	);
-    tr.destroy(thread);
+drain_commands :: proc(using mixer: ^Mixer) {
+    head := sync.atomic_load_explicit(&commands.head, .Relaxed);
+    tail := sync.atomic_load_explicit(&commands.tail, .Acquire);
+    for ; head < tail; head += 1 {
+        command := &commands.commands[head & (COMMAND_QUEUE_CAPACITY - 1)];
+        switch command.kind {
+            case .Play:
+                if !command.start.config.blend && (_queue_busy(mixer) || queue.count > 0) {
+                    if !_queue_push(&queue, command.start) {
+                        sync.atomic_add_explicit(&dropped_voices, 1, .Relaxed);
+                        _dump_start(&command.start);
+                    }
+                } else do _assign_voice(mixer, command.start);
+            case .Pause:
+                if command.sound == ALL_SOUNDS { paused = true; change_queue_state(&queue, .Paused); }
+                else do for &voice in voices do if voice.sound == command.sound && voice.state == .Playing do voice.state = .Paused;
+            case .Resume:
+                if command.sound == ALL_SOUNDS { paused = false; change_queue_state(&queue, .Playing); }
+                for &voice in voices do if (command.sound == ALL_SOUNDS || voice.sound == command.sound) && voice.state == .Paused do voice.state = .Playing;
+            case .Stop:
+                if command.sound == ALL_SOUNDS {
+                    previous := queue.state;
+                    change_queue_state(&queue, .Stopped);
+                    change_queue_state(&queue, previous);
+                } else do _queue_remove(&queue, command.sound);
+                for &voice in voices do if command.sound == ALL_SOUNDS || voice.sound == command.sound do _stop_voice(&voice);
+            case .Dequeue:
+                _queue_remove(&queue, command.sound);
+            case .Volume:
+                if command.sound == ALL_SOUNDS do master_volume = command.volume;
+                else do for &voice in voices do if voice.sound == command.sound do voice.volume = command.volume;
+        }
+    }
+    sync.atomic_store_explicit(&commands.head, head, .Release);
 }
 
+/**
+ * @brief returns once every command pushed before the call has been applied (e.g. no voice reads a sound anymore after 'stop')
+ */
 @(private="package")
-dump_scheduler :: proc(using scheduler: Scheduler) {
-	if thread != nil do tr.destroy(thread);
-}
\ No newline at end of file
+sync_commands :: proc(using mixer: ^Mixer) {
+    target := sync.atomic_load_explicit(&commands.tail, .Acquire);
+    for sync.atomic_load_explicit(&commands.head, .Acquire) < target {
+        // no mix thread (or it quit on a sink error): nobody else consumes the queue
+        if !sync.atomic_load_explicit(&running, .Acquire) {
+            drain_commands(mixer);
+            return;
+        }
+        thread.yield();
+    }
+}
+
+/* MIX THREAD */
+/**
+ * @brief starts the mix thread: it renders a block, hands it to the sink and, unless the sink blocks itself, sleeps until the block would have been played
+ */
+start_engine :: proc(using mixer: ^Mixer) -> bool {
+    if sync.atomic_load_explicit(&running, .Acquire) do return true;
+    stop_engine(mixer); // a thread that quit on a sink error
+    sync.atomic_store_explicit(&running, true, .Release);
+    mix_thread = thread.create_and_start_with_data(mixer, _mix_loop);
+    if mix_thread == nil {
+        sync.atomic_store_explicit(&running, false, .Release);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief joins the mix thread, the voices keep their state and continue with the next 'start_engine' or 'render'
+ */
+stop_engine :: proc(using mixer: ^Mixer) {
+    if mix_thread == nil do return;
+    sync.atomic_store_explicit(&running, false, .Release);
+    thread.join(mix_thread);
+    thread.destroy(mix_thread);
+    mix_thread = nil;
+}
+
+/**
+ * @brief renders "frames" (rounded up to whole blocks) into the sink on the calling thread, as fast as it goes: offline rendering, deterministic tests, benchmarks
+ * @return false if the sink failed to write a block
+ */
+render :: proc(using mixer: ^Mixer, frames: int) -> bool {
+    assert(!sync.atomic_load_explicit(&running, .Acquire), "render while the mix thread is running!");
+    for rendered := 0; rendered < frames; rendered += MIXER_BLOCK_FRAMES {
+        render_block(mixer);
+        if !sink.write(sink.data, bus, sink.num_channels) {
+            sync.atomic_store_explicit(&sink_failed, true, .Release);
+            return false;
+        }
+    }
+    return true;
+}
+
+@(private="file")
+_mix_loop :: proc(data: rawptr) {
+    using mixer := cast(^Mixer)data;
+    block_duration := time.Duration(i64(MIXER_BLOCK_FRAMES) * i64(time.Second) / i64(sink.sample_rate));
+    deadline := time.tick_now();
+    for sync.atomic_load_explicit(&running, .Acquire) {
+        render_block(mixer);
+        if !sink.write(sink.data, bus, sink.num_channels) {
+            sync.atomic_store_explicit(&sink_failed, true, .Release);
+            sync.atomic_store_explicit(&running, false, .Release);
+            break;
+        }
+        if sink.blocking do continue;
+
+        deadline = time.tick_add(deadline, block_duration);
+        if ahead := time.tick_diff(time.tick_now(), deadline); ahead > 0 do time.sleep(ahead);
+        else do deadline = time.tick_now(); // fell behind, do not try to catch up with a burst of blocks
+    }
+    // commands pushed after the loop stopped are applied by the next 'render'/'start_engine'
+}
+/*! MIX THREAD */
@@ -0,0 +1,201 @@
+package main
+
+import "core:fmt"
+import "core:log"
+import "core:math"
+import "core:os"
+import "core:slice"
+
+import mixer "../../mixer"
+
+RAMP_FILE     :: "test_ramp.wav";     // mono 32 bit float, RAMP_FRAMES frames of (i % 100) / 200
+CONSTANT_FILE :: "test_constant.wav"; // mono 32 bit float, CONSTANT_FRAMES frames of CONSTANT_VALUE
+RENDER_FILE   :: "test_render.wav";   // stereo 32 bit float, so that the rendered samples are compared exactly
+RAMP_FRAMES     :: 1_000;
+CONSTANT_FRAMES :: 300;
+CONSTANT_VALUE  :: f32(-0.25);
+EPSILON         :: 1e-6;
+BLOCK           :: mixer.MIXER_BLOCK_FRAMES;
+
+ramp :: proc(frame: int) -> f32 {
+    return f32(frame % 100) / 200;
+}
+
+write_sources :: proc() {
+    samples := make([]f32, RAMP_FRAMES);
+    defer delete(samples);
+    for &sample, i in samples do sample = ramp(i);
+    assert(mixer.write_wav(RAMP_FILE, samples, mixer.SoundChannelTypeMono, mixer.DEFAULT_SAMPLE_RATE));
+    for &sample in samples[:CONSTANT_FRAMES] do sample = CONSTANT_VALUE;
+    assert(mixer.write_wav(CONSTANT_FILE, samples[:CONSTANT_FRAMES], mixer.SoundChannelTypeMono, mixer.DEFAULT_SAMPLE_RATE));
+}
+
+/**
+ * @brief a mixer rendering into RENDER_FILE with both sources loaded
+ */
+Session :: struct {
+    m:        mixer.Mixer,
+    ramp:     mixer.SoundID,
+    constant: mixer.SoundID,
+}
+
+begin_session :: proc(s: ^Session) {
+    sink, ok := mixer.init_wav_sink(RENDER_FILE, mixer.DEFAULT_SAMPLE_RATE, mixer.SoundChannelTypeStereo, .IEEE_FLOAT_FORMAT);
+    assert(ok);
+    s.m = mixer.init(sink);
+    ramp_ok, constant_ok: bool;
+    s.ramp, ramp_ok = mixer.load(&s.m, RAMP_FILE);
+    s.constant, constant_ok = mixer.load(&s.m, CONSTANT_FILE);
+    assert(ramp_ok && constant_ok);
+}
+
+/**
+ * @brief dumps the mixer (the sink fills in the header) and reads the rendered file back
+ * @return the whole file and its interleaved stereo samples, delete "data" once done with both
+ */
+end_session :: proc(s: ^Session) -> (data: []u8, samples: []f32) {
+    mixer.dump(&s.m);
+    ok: bool;
+    data, ok = os.read_entire_file(RENDER_FILE);
+    assert(ok && len(data) >= mixer.WAV_HEADER_SIZE);
+    return data, slice.reinterpret([]f32, data[mixer.WAV_HEADER_SIZE:]);
+}
+
+/**
+ * @brief both channels of the frames [first, first + count) have to hold expected(frame - first)
+ */
+expect_frames :: proc(name: string, samples: []f32, first, count: int, expected: proc(frame: int) -> f32) {
+    fmt.assertf(len(samples) >= 2 * (first + count), "\x1b[31m[%v] %v frames rendered, %v expected\x1b[0m\n", name, len(samples) / 2, first + count);
+    for frame in first..<first + count {
+        want := expected(frame - first);
+        for c in 0..<2 {
+            got := samples[2 * frame + c];
+            fmt.assertf(abs(got - want) <= EPSILON, "\x1b[31m[%v] frame %v channel %v: %v, %v expected\x1b[0m\n", name, frame, c, got, want);
+        }
+    }
+}
+
+silence :: proc(frame: int) -> f32 { return 0; }
+
+expect_state :: proc(name: string, m: ^mixer.Mixer, state: mixer.PlaybackState) {
+    got := mixer.get_playback_state(m);
+    fmt.assertf(got == state, "\x1b[31m[%v] playback state %v, %v expected\x1b[0m\n", name, got, state);
+}
+
+/**
+ * @brief one voice, mono to stereo at unit gain: the rendered frames are the source, then silence up to the end of the last block
+ */
+test_samples :: proc() {
+    s: Session;
+    begin_session(&s);
+    assert(mixer.play(&s.m, s.ramp));
+    assert(mixer.render(&s.m, 4 * BLOCK));
+    expect_state("samples", &s.m, .Stopped);
+    data, samples := end_session(&s);
+    defer delete(data);
+
+    fmt.assertf(len(samples) == 2 * 4 * BLOCK, "\x1b[31m[samples] %v frames rendered, %v expected\x1b[0m\n", len(samples) / 2, 4 * BLOCK);
+    expect_frames("samples", samples, 0, RAMP_FRAMES, ramp);
+    expect_frames("samples", samples, RAMP_FRAMES, 4 * BLOCK - RAMP_FRAMES, silence);
+    log.infof("[samples] %v frames match the source", RAMP_FRAMES);
+}
+
+/**
+ * @brief sounds played without blend wait for the previous one and follow it without a gap, even in the middle of a block
+ */
+test_queue :: proc() {
+    s: Session;
+    begin_session(&s);
+    assert(mixer.enqueue_sound(&s.m, s.ramp));
+    assert(mixer.enqueue_sound(&s.m, s.constant));
+    assert(mixer.render(&s.m, 6 * BLOCK));
+    data, samples := end_session(&s);
+    defer delete(data);
+
+    second := RAMP_FRAMES;
+    expect_frames("queue", samples, 0, RAMP_FRAMES, ramp);
+    expect_frames("queue", samples, second, CONSTANT_FRAMES, proc(frame: int) -> f32 { return CONSTANT_VALUE; });
+    expect_frames("queue", samples, second + CONSTANT_FRAMES, 6 * BLOCK - second - CONSTANT_FRAMES, silence);
+    log.infof("[queue] the second sound starts at frame %v", second);
+}
+
+/**
+ * @brief a paused mixer renders silence and resumes where it was, a stopped voice does not come back
+ */
+test_pause_stop :: proc() {
+    s: Session;
+    begin_session(&s);
+    config := mixer.DEFAULT_PLAYBACK_SOUND_CONFIG;
+    config.blend   = true;
+    config.looping = true;
+    assert(mixer.play(&s.m, s.ramp, config));
+    assert(mixer.render(&s.m, BLOCK));
+    expect_state("pause/stop", &s.m, .Playing);
+    assert(mixer.pause(&s.m));
+    assert(mixer.render(&s.m, BLOCK));
+    expect_state("pause/stop", &s.m, .Paused);
+    assert(mixer.resume(&s.m));
+    assert(mixer.render(&s.m, BLOCK));
+    expect_state("pause/stop", &s.m, .Playing);
+    assert(mixer.stop(&s.m));
+    assert(mixer.render(&s.m, BLOCK));
+    expect_state("pause/stop", &s.m, .Stopped);
+    data, samples := end_session(&s);
+    defer delete(data);
+
+    expect_frames("pause/stop", samples, 0, BLOCK, ramp);
+    expect_frames("pause/stop", samples, BLOCK, BLOCK, silence);
+    expect_frames("pause/stop", samples, 2 * BLOCK, BLOCK, proc(frame: int) -> f32 { return ramp(BLOCK + frame); });
+    expect_frames("pause/stop", samples, 3 * BLOCK, BLOCK, silence);
+    log.infof("[pause/stop] paused and stopped blocks are silent, the voice resumed at frame %v", BLOCK);
+}
+
+/**
+ * @brief two voices of a sound with a low pass start together: each filters with its own state, so the mix is twice the filtered source
+ * @note the chain of the sound is replaced while they play, the voices keep their clones
+ */
+test_voice_effects :: proc() {
+    CUTOFF :: 1_000;
+    s: Session;
+    begin_session(&s);
+    effect := mixer.init_effect();
+    mixer.push_low_pass(&effect, CUTOFF);
+    mixer.apply_audio_effect(&s.m.cache[s.ramp], effect);
+    config := mixer.DEFAULT_PLAYBACK_SOUND_CONFIG;
+    config.blend = true;
+    assert(mixer.play(&s.m, s.ramp, config));
+    assert(mixer.play(&s.m, s.ramp, config));
+    assert(mixer.render(&s.m, BLOCK));
+    mixer.apply_audio_effect(&s.m.cache[s.ramp], mixer.init_effect());
+    assert(mixer.render(&s.m, 3 * BLOCK));
+    data, samples := end_session(&s);
+    defer delete(data);
+
+    a := 1 - math.exp(-2 * math.PI * f32(CUTOFF) / f32(mixer.DEFAULT_SAMPLE_RATE));
+    y: f32;
+    for frame in 0..<RAMP_FRAMES {
+        y += a * (ramp(frame) - y);
+        for c in 0..<2 {
+            got := samples[2 * frame + c];
+            fmt.assertf(abs(got - 2 * y) <= 1e-5, "\x1b[31m[voice effects] frame %v channel %v: %v, %v expected\x1b[0m\n", frame, c, got, 2 * y);
+        }
+    }
+    log.infof("[voice effects] both voices filtered from their own state");
+}
+
+main :: proc() {
+    context.logger = log.create_console_logger();
+    write_sources();
+    defer {
+        os.remove(RAMP_FILE);
+        os.remove(CONSTANT_FILE);
+        os.remove(RENDER_FILE);
+    }
+
+    test_samples();
+    test_queue();
+    test_pause_stop();
+    test_voice_effects();
+
+    fmt.printf("\x1b[32mmixer render tests passed!\x1b[0m\n");
+}
@@ -0,0 +1,125 @@
+package main
+
+import "base:intrinsics"
+import "core:fmt"
+import "core:thread"
+import "core:time"
+
+import performance "../../performance_profiler"
+
+ITERATIONS :: 1_000_000;
+THREADS    :: 4;
+
+/**
+ * @brief the loops below differ only in the zones they open, the difference in time per iteration is the cost of a zone
+ */
+@(optimization_mode="none")
+_work :: #force_no_inline proc(value: ^int) {
+    value^ += 1;
+}
+
+baseline :: proc() -> time.Duration {
+    value := 0;
+    start := time.tick_now();
+    for _ in 0..<ITERATIONS do _work(&value);
+    return time.tick_since(start);
+}
+
+flat_zones :: proc() -> time.Duration {
+    value := 0;
+    start := time.tick_now();
+    for _ in 0..<ITERATIONS {
+        performance.ZONE("flat");
+        _work(&value);
+    }
+    return time.tick_since(start);
+}
+
+nested_zones :: proc() -> time.Duration {
+    value := 0;
+    start := time.tick_now();
+    for _ in 0..<ITERATIONS {
+        performance.ZONE("outer");
+        {
+            performance.ZONE("inner");
+            _work(&value);
+        }
+    }
+    return time.tick_since(start);
+}
+
+cpu_timer :: proc() -> time.Duration {
+    timer := performance.init_cpu_timer();
+    defer performance.dump_cpu_timer(&timer);
+    value := 0;
+    start := time.tick_now();
+    for _ in 0..<ITERATIONS {
+        performance.begin(&timer);
+        _work(&value);
+        performance.end(&timer);
+    }
+    return time.tick_since(start);
+}
+
+report :: proc(name: string, duration, base: time.Duration, zones_per_iteration: int) {
+    per_iteration := f64(duration) / ITERATIONS;
+    overhead := (f64(duration) - f64(base)) / ITERATIONS / f64(max(zones_per_iteration, 1));
+    fmt.printf("\t%-28s %12.3f %14.2f %16.2f\n", name, time.duration_milliseconds(duration), per_iteration, overhead);
+}
+
+main :: proc() {
+    performance.init_zone_profiler();
+    defer performance.dump_zone_profiler();
+
+    sampler: performance.Process_Sampler;
+    sampling := performance.start_process_sampler(&sampler, 10 * time.Millisecond);
+    defer performance.dump_process_sampler(&sampler);
+
+    fmt.printf("Beginning [ZONE PROFILER BENCHMARK] %v iterations (zones %v)\n", ITERATIONS, performance.PROFILER_ENABLED ? "enabled" : "compiled out");
+    fmt.printf("-----------------------------\n");
+    {
+        start := intrinsics.read_cycle_counter();
+        for _ in 0..<ITERATIONS do _ = intrinsics.read_cycle_counter();
+        fmt.printf("\tcycle counter: %.3f ns per tick, %.2f ns per read\n", performance.ticks_to_nanoseconds(1), performance.ticks_to_nanoseconds(intrinsics.read_cycle_counter() - start) / ITERATIONS);
+    }
+    fmt.printf("\t%-28s %12s %14s %16s\n", "loop", "time [ms]", "ns/iteration", "ns/zone (over)");
+
+    base := baseline();
+    report("baseline", base, base, 0);
+    report("ZONE", flat_zones(), base, 1);
+    report("ZONE (nested 2 deep)", nested_zones(), base, 2);
+    report("CPUTimer begin/end", cpu_timer(), base, 1);
+
+    // the rings are per thread, so more threads must not make a zone more expensive
+    {
+        threads: [THREADS]^thread.Thread;
+        durations: [THREADS]time.Duration;
+        for &t, i in threads {
+            t = thread.create_and_start_with_data(&durations[i], proc(data: rawptr) {
+                (cast(^time.Duration)data)^ = flat_zones();
+            });
+        }
+        for t in threads {
+            thread.join(t);
+            thread.destroy(t);
+        }
+        worst: time.Duration;
+        for duration in durations do worst = max(worst, duration);
+        report(fmt.tprintf("ZONE (%v threads, slowest)", THREADS), worst, base, 1);
+    }
+
+    {
+        start   := time.tick_now();
+        records := performance.collect_zones();
+        defer delete(records);
+        stats   := performance.zone_stats(records);
+        defer delete(stats);
+        fmt.printf("\n\tcollected %v zones and aggregated them in %.3f ms\n\n", len(records), time.duration_milliseconds(time.tick_since(start)));
+        performance.print_zone_stats(stats);
+        performance.stop_process_sampler(&sampler);
+        samples := performance.process_samples(&sampler);
+        defer delete(samples);
+        if sampling do fmt.printf("\n\t%v process samples (every 10 ms)\n", len(samples));
+        performance.export_chrome_trace("benchmark_trace.json", records, samples);
+    }
+}
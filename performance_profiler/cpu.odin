@@ -28,39 +28,47 @@ end_time_stamp :: #force_inline proc "contextless" (using stamp: ^CPUTimeStamp)
     end = time.now()._nsec; 
 }
 
-delta_seconds :: #force_inline proc "contextless" (using cpu: ^CPUTimeStamp) -> i64 {
-    return (end - begin) / 1e9;
+delta_seconds :: #force_inline proc "contextless" (using cpu: ^CPUTimeStamp) -> f64 {
+    return f64(end - begin) / 1e9;
 }
 
-delta_milliseconds :: #force_inline proc "contextless" (using cpu: ^CPUTimeStamp) -> i64 {
-    return (end - begin) / 1e6;
+delta_milliseconds :: #force_inline proc "contextless" (using cpu: ^CPUTimeStamp) -> f64 {
+    return f64(end - begin) / 1e6;
 }
 
-delta_microseconds :: #force_inline proc "contextless" (using cpu: ^CPUTimeStamp) -> i64 {
-    return (end - begin) / 1e3;
+delta_microseconds :: #force_inline proc "contextless" (using cpu: ^CPUTimeStamp) -> f64 {
+    return f64(end - begin) / 1e3;
 }
 
+/**
+ * @brief 'begin'/'end' pairs nest, 'end' closes the innermost stamp still open
+ * @note one timer per thread; for profiling across threads (and at a fraction of the cost) @see ZONE
+ */
 CPUTimer :: struct {
     stamps : [dynamic]CPUTimeStamp,
+    open   : [dynamic]int,
 }
 
 init_cpu_timer :: proc() -> CPUTimer {
     return CPUTimer {
         stamps = make([dynamic]CPUTimeStamp),
+        open   = make([dynamic]int),
     };
 }
 
 begin :: proc(using timer: ^CPUTimer, location := #caller_location) {
-    stamp: CPUTimeStamp = {};
-    stamp = begin_time_stamp(location);
-    append(&stamps, stamp);
+    append(&open, len(stamps));
+    append(&stamps, begin_time_stamp(location));
 }
 
-end :: proc(using timer: ^CPUTimer) -> ^CPUTimeStamp {
-    end_time_stamp(&stamps[len(stamps) - 1]);
-    return &stamps[len(stamps) - 1];
+end :: proc(using timer: ^CPUTimer, location := #caller_location) -> ^CPUTimeStamp {
+    assert(len(open) > 0, "'end' without a matching 'begin'!", location);
+    stamp := &stamps[pop(&open)];
+    end_time_stamp(stamp);
+    return stamp;
 }
 
 dump_cpu_timer :: proc(timer: ^CPUTimer) {
     delete(timer^.stamps);
-}
\ No newline at end of file
+    delete(timer^.open);
+}
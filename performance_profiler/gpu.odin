@@ -1,3 +1,4 @@
+//+build windows
 package performance_profiler
 
 import D3D11 "vendor:directx/d3d11"
@@ -0,0 +1,13 @@
+//+build !windows
+package performance_profiler
+
+/**
+ * @note GPU timestamps are read through D3D11 queries, other platforms get an empty timer
+ */
+GPUTimer :: struct {}
+
+init_gpu_timer :: proc() -> GPUTimer {
+    return {};
+}
+
+dump_gpu_timer :: proc(timer: ^GPUTimer) {}
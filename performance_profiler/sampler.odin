@@ -0,0 +1,89 @@
+package performance_profiler
+
+import "base:intrinsics"
+import "base:runtime"
+import "core:sync"
+import "core:thread"
+import "core:time"
+
+/**
+ * @brief one reading of the process; "time" is a cycle counter tick, on the same timeline as the zones
+ * @note "cpu_percent" is relative to one core, a process keeping 4 cores busy reads 400
+ */
+Process_Sample :: struct {
+    time:        i64,
+    cpu_percent: f64,
+    rss_bytes:   int,
+}
+
+/**
+ * @brief background thread reading the CPU time and resident memory of the process every "interval"
+ */
+Process_Sampler :: struct {
+    thread:   ^thread.Thread,
+    interval: time.Duration,
+    running:  bool,
+    mutex:    sync.Mutex,
+    samples:  [dynamic]Process_Sample,
+}
+
+/**
+ * @return false when the platform has no sampler (@see read_process_usage)
+ */
+start_process_sampler :: proc(sampler: ^Process_Sampler, interval := 100 * time.Millisecond) -> bool {
+    if _, _, ok := read_process_usage(); !ok do return false;
+
+    sampler.interval = interval;
+    sampler.samples  = make([dynamic]Process_Sample, runtime.heap_allocator());
+    sync.atomic_store(&sampler.running, true);
+    sampler.thread = thread.create_and_start_with_data(sampler, _process_sampler_loop);
+    return true;
+}
+
+stop_process_sampler :: proc(sampler: ^Process_Sampler) {
+    if sampler.thread == nil do return;
+    sync.atomic_store(&sampler.running, false);
+    thread.join(sampler.thread);
+    thread.destroy(sampler.thread);
+    sampler.thread = nil;
+}
+
+/**
+ * @brief copy of the samples taken so far
+ */
+process_samples :: proc(sampler: ^Process_Sampler, allocator := context.allocator) -> []Process_Sample {
+    sync.mutex_lock(&sampler.mutex);
+    defer sync.mutex_unlock(&sampler.mutex);
+    samples := make([]Process_Sample, len(sampler.samples), allocator);
+    copy(samples, sampler.samples[:]);
+    return samples;
+}
+
+dump_process_sampler :: proc(sampler: ^Process_Sampler) {
+    stop_process_sampler(sampler);
+    delete(sampler.samples);
+}
+
+@(private="file")
+_process_sampler_loop :: proc(data: rawptr) {
+    sampler := cast(^Process_Sampler)data;
+    last_cpu, _, _ := read_process_usage();
+    last_time := time.tick_now();
+    for sync.atomic_load(&sampler.running) {
+        time.sleep(sampler.interval);
+
+        cpu, rss, ok := read_process_usage();
+        if !ok do continue;
+        now := time.tick_now();
+        sample := Process_Sample{
+            time        = intrinsics.read_cycle_counter(),
+            cpu_percent = 100 * f64(cpu - last_cpu) / f64(max(time.tick_diff(last_time, now), 1)),
+            rss_bytes   = rss,
+        };
+        last_cpu, last_time = cpu, now;
+
+        sync.mutex_lock(&sampler.mutex);
+        append(&sampler.samples, sample);
+        sync.mutex_unlock(&sampler.mutex);
+    }
+}
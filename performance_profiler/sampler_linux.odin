@@ -0,0 +1,43 @@
+//+build linux
+package performance_profiler
+
+import "core:os"
+import "core:strconv"
+import "core:strings"
+
+@(private="file")
+USER_HZ :: 100; // unit of the times in /proc, fixed by the kernel ABI
+
+/**
+ * @brief CPU time (user + system, in ns) and resident set size of this process, from /proc/self/stat
+ */
+read_process_usage :: proc() -> (cpu_time_ns: i64, rss_bytes: int, ok: bool) {
+    handle, err := os.open("/proc/self/stat", os.O_RDONLY);
+    if err != os.ERROR_NONE do return;
+    defer os.close(handle);
+
+    buffer: [1024]u8;
+    read, read_err := os.read(handle, buffer[:]);
+    if read_err != os.ERROR_NONE || read <= 0 do return;
+
+    // the name of the executable (2nd field) is in parentheses and may contain spaces, the fields are counted from the last ')'
+    stat := string(buffer[:read]);
+    name_end := strings.last_index_byte(stat, ')');
+    if name_end < 0 do return;
+    // counted from the 3rd field (state): utime is the 14th, stime the 15th, rss the 24th (in pages)
+    utime, stime, rss: i64;
+    found := 0;
+    rest := stat[name_end + 1:];
+    index := 3;
+    for field in strings.fields_iterator(&rest) {
+        switch index {
+            case 14: utime = strconv.parse_i64(field) or_return; found += 1;
+            case 15: stime = strconv.parse_i64(field) or_return; found += 1;
+            case 24: rss   = strconv.parse_i64(field) or_return; found += 1;
+        }
+        index += 1;
+    }
+    if found != 3 do return;
+
+    return (utime + stime) * (1e9 / USER_HZ), int(rss) * os.get_page_size(), true;
+}
@@ -0,0 +1,9 @@
+//+build !linux
+package performance_profiler
+
+/**
+ * @note not implemented on this platform, the sampler refuses to start
+ */
+read_process_usage :: proc() -> (cpu_time_ns: i64, rss_bytes: int, ok: bool) {
+    return;
+}
@@ -0,0 +1,73 @@
+package performance_profiler
+
+import "core:fmt"
+import "core:os"
+import "core:strings"
+
+@(private="file")
+TRACE_PID :: 1; // one process per trace file
+
+/**
+ * @brief writes "records" (and optionally the process "samples" as counters) as Chrome trace event JSON, viewable in chrome://tracing or Perfetto
+ * @note timestamps are microseconds since 'init_zone_profiler'
+ */
+export_chrome_trace :: proc(file_path: string, records: []Zone_Record, samples: []Process_Sample = nil) -> bool {
+    b := strings.builder_make();
+    defer strings.builder_destroy(&b);
+
+    strings.write_string(&b, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    first := true;
+    for &record in records {
+        if !first do strings.write_string(&b, ",\n");
+        first = false;
+
+        strings.write_string(&b, "{\"name\":");
+        _write_json_string(&b, len(record.name) > 0 ? record.name : record.location.procedure);
+        fmt.sbprintf(
+            &b, ",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%v,\"tid\":%v,\"args\":{\"depth\":%v,\"line\":%v,\"file\":",
+            ticks_to_nanoseconds(record.begin - _profiler.epoch) / 1e3, ticks_to_nanoseconds(record.end - record.begin) / 1e3,
+            TRACE_PID, record.thread_id, record.depth, record.location.line,
+        );
+        _write_json_string(&b, record.location.file_path);
+        strings.write_string(&b, "}}");
+    }
+    for sample in samples {
+        if !first do strings.write_string(&b, ",\n");
+        first = false;
+        fmt.sbprintf(
+            &b, "{\"name\":\"process\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%v,\"args\":{\"cpu [%%]\":%.2f,\"rss [MB]\":%.3f}}",
+            ticks_to_nanoseconds(sample.time - _profiler.epoch) / 1e3, TRACE_PID, sample.cpu_percent, f64(sample.rss_bytes) / (1024 * 1024),
+        );
+    }
+    strings.write_string(&b, "\n]}\n");
+
+    return os.write_entire_file(file_path, b.buf[:]);
+}
+
+/**
+ * @brief table of 'zone_stats' printed to stdout
+ */
+print_zone_stats :: proc(stats: []Zone_Stats) {
+    fmt.printf("\t%-32s %10s %14s %12s %12s %12s %12s\n", "zone", "count", "total [ms]", "min [us]", "avg [us]", "p99 [us]", "max [us]");
+    for &stat in stats {
+        fmt.printf(
+            "\t%-32s %10v %14.3f %12.3f %12.3f %12.3f %12.3f\n",
+            len(stat.name) > 0 ? stat.name : stat.location.procedure, stat.count,
+            stat.total_ns / 1e6, stat.min_ns / 1e3, stat.avg_ns / 1e3, stat.p99_ns / 1e3, stat.max_ns / 1e3,
+        );
+    }
+}
+
+@(private="file")
+_write_json_string :: proc(b: ^strings.Builder, value: string) {
+    strings.write_byte(b, '"');
+    for c in transmute([]u8)value {
+        switch c {
+            case '"':  strings.write_string(b, "\\\"");
+            case '\\': strings.write_string(b, "\\\\");
+            case 0..<0x20: fmt.sbprintf(b, "\\u%04x", c);
+            case: strings.write_byte(b, c);
+        }
+    }
+    strings.write_byte(b, '"');
+}
@@ -0,0 +1,240 @@
+package performance_profiler
+
+import "base:intrinsics"
+import "base:runtime"
+import "core:math"
+import "core:os"
+import "core:slice"
+import "core:sync"
+import "core:time"
+
+/**
+ * @brief zones compile to nothing with -define:PERFORMANCE_PROFILER=false ('Zone' becomes an empty struct and every zone procedure an empty body)
+ */
+PROFILER_ENABLED :: #config(PERFORMANCE_PROFILER, true);
+
+/**
+ * @brief events kept per thread, the oldest are overwritten once the ring is full (must be a power of 2)
+ */
+ZONE_RING_CAPACITY :: 1 << 14;
+#assert(ZONE_RING_CAPACITY & (ZONE_RING_CAPACITY - 1) == 0);
+
+/**
+ * @brief one closed zone; begin and end are raw ticks of the cycle counter (@see ticks_to_nanoseconds)
+ */
+Zone_Event :: struct {
+    begin, end: i64,
+    name:       string,
+    location:   runtime.Source_Code_Location,
+    depth:      i32,
+}
+
+/**
+ * @brief single producer ring: only the owning thread writes events, 'head' (events written so far) is published with release semantics
+ */
+@(private)
+Thread_Buffer :: struct {
+    events:    [ZONE_RING_CAPACITY]Zone_Event,
+    head:      u64,
+    depth:     i32,
+    thread_id: int,
+    next:      ^Thread_Buffer,
+}
+
+@(private)
+Zone_Profiler :: struct {
+    buffers:      ^Thread_Buffer, // lock-free list, every thread pushes its buffer the first time it opens a zone
+    generation:   u64,            // bumped by 'dump_zone_profiler', so that the buffer cached by a thread before the dump is never used again
+    epoch:        i64,
+    ns_per_tick:  f64,
+}
+
+@(private)
+_profiler: Zone_Profiler;
+
+@(private)
+Local_Buffer :: struct {
+    generation: u64,
+    buffer:     ^Thread_Buffer,
+}
+
+@(private, thread_local)
+_local_buffer: Local_Buffer;
+
+/**
+ * @brief calibrates the cycle counter against the monotonic clock by spinning for "calibration"
+ * @note the counter has to tick at a constant rate (invariant TSC on x86, the generic timer on arm64)
+ */
+init_zone_profiler :: proc(calibration := 20 * time.Millisecond) {
+    tick_begin    := time.tick_now();
+    counter_begin := intrinsics.read_cycle_counter();
+    for time.tick_since(tick_begin) < calibration {}
+    elapsed := time.tick_since(tick_begin);
+    counter := intrinsics.read_cycle_counter() - counter_begin;
+
+    _profiler.epoch       = counter_begin;
+    _profiler.ns_per_tick = f64(elapsed) / f64(max(counter, 1));
+}
+
+/**
+ * @note frees the buffers of every thread, none of them may be inside a zone anymore
+ * @note threads that keep running register a new buffer with their next zone (@see Zone_Profiler.generation)
+ */
+dump_zone_profiler :: proc() {
+    sync.atomic_add_explicit(&_profiler.generation, 1, .Release);
+    buffer := sync.atomic_exchange_explicit(&_profiler.buffers, nil, .Acq_Rel);
+    for buffer != nil {
+        next := buffer.next;
+        free(buffer, runtime.heap_allocator());
+        buffer = next;
+    }
+}
+
+/**
+ * @note the cycle counter has to be calibrated first (@see init_zone_profiler)
+ */
+ticks_to_nanoseconds :: #force_inline proc(ticks: i64) -> f64 {
+    assert(_profiler.ns_per_tick > 0, "The zone profiler was not initialized (init_zone_profiler)!");
+    return f64(ticks) * _profiler.ns_per_tick;
+}
+
+@(private)
+_thread_buffer :: #force_inline proc() -> ^Thread_Buffer {
+    generation := sync.atomic_load_explicit(&_profiler.generation, .Acquire);
+    if _local_buffer.buffer == nil || _local_buffer.generation != generation do _register_thread_buffer(generation);
+    return _local_buffer.buffer;
+}
+
+@(private)
+_register_thread_buffer :: proc(generation: u64) {
+    buffer := new(Thread_Buffer, runtime.heap_allocator());
+    buffer.thread_id = os.current_thread_id();
+    for {
+        head := sync.atomic_load_explicit(&_profiler.buffers, .Acquire);
+        buffer.next = head;
+        if _, ok := sync.atomic_compare_exchange_weak_explicit(&_profiler.buffers, head, buffer, .Release, .Relaxed); ok do break;
+    }
+    _local_buffer = { generation, buffer };
+}
+
+when PROFILER_ENABLED {
+    Zone :: struct {
+        begin:    i64,
+        name:     string,
+        location: runtime.Source_Code_Location,
+    }
+
+    zone_begin :: #force_inline proc(name := "", location := #caller_location) -> Zone {
+        _thread_buffer().depth += 1;
+        return { begin = intrinsics.read_cycle_counter(), name = name, location = location, };
+    }
+
+    /**
+     * @brief closes "zone" on the thread that opened it
+     */
+    zone_end :: #force_inline proc(zone: Zone) {
+        end := intrinsics.read_cycle_counter();
+        buffer := _thread_buffer();
+        buffer.depth -= 1;
+        head := sync.atomic_load_explicit(&buffer.head, .Relaxed);
+        #no_bounds_check buffer.events[head & (ZONE_RING_CAPACITY - 1)] = { zone.begin, end, zone.name, zone.location, buffer.depth };
+        sync.atomic_store_explicit(&buffer.head, head + 1, .Release);
+    }
+} else {
+    Zone :: struct {}
+
+    zone_begin :: #force_inline proc "contextless" (name := "", location := #caller_location) -> Zone { return {}; }
+    zone_end   :: #force_inline proc "contextless" (zone: Zone) {}
+}
+
+/**
+ * @brief zone closed at the end of the enclosing scope: 'ZONE("decode")' or just 'ZONE()' to name it after the procedure
+ */
+@(deferred_out=zone_end)
+ZONE :: #force_inline proc(name := "", location := #caller_location) -> Zone {
+    return zone_begin(name, location);
+}
+
+/* COLLECTION */
+Zone_Record :: struct {
+    using event: Zone_Event,
+    thread_id:   int,
+}
+
+/**
+ * @brief copies the events currently held by the rings of all threads
+ * @note lock-free with respect to the recording threads: events a thread overwrote while they were being copied are dropped, not torn
+ */
+collect_zones :: proc(allocator := context.allocator) -> []Zone_Record {
+    records := make([dynamic]Zone_Record, allocator);
+    for buffer := sync.atomic_load_explicit(&_profiler.buffers, .Acquire); buffer != nil; buffer = buffer.next {
+        head  := sync.atomic_load_explicit(&buffer.head, .Acquire);
+        first := head > ZONE_RING_CAPACITY ? head - ZONE_RING_CAPACITY : 0;
+        start := len(records);
+        for i in first..<head do append(&records, Zone_Record{ buffer.events[i & (ZONE_RING_CAPACITY - 1)], buffer.thread_id });
+
+        // whatever the owner wrote in the meantime may have landed on the slots of the oldest events
+        // (the slot after the last overwritten one may be half written already, the owner publishes 'head' only once the event is complete)
+        new_head := sync.atomic_load_explicit(&buffer.head, .Acquire);
+        if overwritten := int(new_head - first) - ZONE_RING_CAPACITY; overwritten >= 0 {
+            dropped := min(overwritten + 1, len(records) - start);
+            remove_range(&records, start, start + dropped);
+        }
+    }
+    return records[:];
+}
+
+Zone_Stats :: struct {
+    name:     string,
+    location: runtime.Source_Code_Location,
+    count:    int,
+    total_ns, min_ns, max_ns, avg_ns, p99_ns: f64,
+}
+
+@(private)
+Zone_Key :: struct {
+    name:      string,
+    file_path: string,
+    line:      i32,
+}
+
+/**
+ * @brief per call site (and name) aggregation of "records", ordered by total time
+ */
+zone_stats :: proc(records: []Zone_Record, allocator := context.allocator) -> []Zone_Stats {
+    durations := make(map[Zone_Key][dynamic]f64);
+    locations := make(map[Zone_Key]runtime.Source_Code_Location);
+    defer {
+        for _, values in durations do delete(values);
+        delete(durations);
+        delete(locations);
+    }
+
+    for &record in records {
+        key := Zone_Key{ record.name, record.location.file_path, record.location.line };
+        _, values, just_inserted, _ := map_entry(&durations, key);
+        if just_inserted do locations[key] = record.location;
+        append(values, ticks_to_nanoseconds(record.end - record.begin));
+    }
+
+    stats := make([]Zone_Stats, len(durations), allocator);
+    i := 0;
+    for key, &values in durations {
+        slice.sort(values[:]);
+        total := math.sum(values[:]);
+        stats[i] = {
+            name     = key.name,
+            location = locations[key],
+            count    = len(values),
+            total_ns = total,
+            min_ns   = values[0],
+            max_ns   = values[len(values) - 1],
+            avg_ns   = total / f64(len(values)),
+            p99_ns   = values[max(0, int(math.ceil(0.99 * f64(len(values)))) - 1)], // nearest rank
+        };
+        i += 1;
+    }
+    slice.sort_by(stats, proc(a, b: Zone_Stats) -> bool { return a.total_ns > b.total_ns; });
+    return stats;
+}
+/*! COLLECTION */